@@ -0,0 +1,217 @@
+/// @file
+/// @brief Defines Holiday::AdaptiveHolidayCalendar, a holiday calendar
+///        that sizes its cached range from the years actually queried.
+#pragma once
+
+#include "Date.hpp"
+#include "HolidayCalendar.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief A holiday calendar that caches the most frequently queried
+///        years that fit within a memory budget.
+///
+///        Years are grouped into blocks of blockYears.  Queries count hits
+///        per block, and every window queries the calendar picks the
+///        contiguous run of blocks with the most hits that fits in the
+///        budget and re-caches that run if it differs from the current one,
+///        growing, shrinking or moving the cached span to follow the hot
+///        region.  Years outside the span are answered from the rules.
+///        The number of blocks that fit is worked out from the size of a
+///        single cached block before anything is cached, so each window
+///        caches at most once.
+///
+///        MemoryUsage() never exceeds the budget after a query returns.
+///        Queries are not const since they may rebuild the cache, so a
+///        calendar must not be shared between threads without locking.
+template <class Holidays, class Storage = SortedHolidayStorage>
+class AdaptiveHolidayCalendar
+{
+public:
+    /// @brief Creates a calendar with no cache
+    /// @param memoryBudget maximum bytes the cache may use
+    /// @param window number of queries between resizing decisions
+    /// @param blockYears number of years cached or dropped together
+    AdaptiveHolidayCalendar(std::size_t memoryBudget,
+                            unsigned window = 4096,
+                            int blockYears = 8);
+    /// @brief Returns true if the provided date is a holiday
+    bool IsMarketHoliday(int year, int month, int day);
+    /// @brief Returns true if the provided date is a holiday
+    bool IsMarketHoliday(int yyyymmdd);
+    /// @brief Returns true if the provided date is a holiday
+    bool IsMarketHoliday(const Date& date);
+    /// @brief First cached year, greater than EndYear() if none are cached
+    int StartYear() const;
+    /// @brief Last cached year
+    int EndYear() const;
+    /// @brief Approximate number of bytes allocated by the cache
+    std::size_t MemoryUsage() const;
+private:
+    int BlockOf(int year) const;
+    void Record(const Date& date);
+    void Adapt();
+    int BlocksInBudget() const;
+    void Rebuild(int startBlock, int endBlock);
+    HolidayCalendar<Holidays, Storage> m_Calendar;
+    std::size_t m_MemoryBudget;
+    unsigned m_Window;
+    int m_BlockYears;
+    int m_MaxBlocks;
+    int m_StartBlock;
+    int m_EndBlock;
+    unsigned m_Queries;
+    std::vector<unsigned> m_CachedHits;
+    std::map<int, unsigned> m_UncachedHits;
+};
+
+template <class Holidays, class Storage>
+AdaptiveHolidayCalendar<Holidays, Storage>::AdaptiveHolidayCalendar(std::size_t memoryBudget,
+                                                                    unsigned window,
+                                                                    int blockYears)
+{
+    m_MemoryBudget = memoryBudget;
+    m_Window = window == 0 ? 1 : window;
+    m_BlockYears = blockYears < 1 ? 1 : blockYears;
+    // measured on the first Adapt
+    m_MaxBlocks = -1;
+    m_StartBlock = 0;
+    m_EndBlock = -1;
+    m_Queries = 0;
+}
+template <class Holidays, class Storage>
+bool AdaptiveHolidayCalendar<Holidays, Storage>::IsMarketHoliday(int year, int month, int day)
+{
+    return IsMarketHoliday(Date(year, month, day));
+}
+template <class Holidays, class Storage>
+bool AdaptiveHolidayCalendar<Holidays, Storage>::IsMarketHoliday(int yyyymmdd)
+{
+    return IsMarketHoliday(Date(yyyymmdd));
+}
+template <class Holidays, class Storage>
+bool AdaptiveHolidayCalendar<Holidays, Storage>::IsMarketHoliday(const Date& date)
+{
+    bool holiday = m_Calendar.IsMarketHoliday(date);
+    Record(date);
+    return holiday;
+}
+template <class Holidays, class Storage>
+int AdaptiveHolidayCalendar<Holidays, Storage>::StartYear() const
+{
+    return m_StartBlock * m_BlockYears;
+}
+template <class Holidays, class Storage>
+int AdaptiveHolidayCalendar<Holidays, Storage>::EndYear() const
+{
+    return m_EndBlock * m_BlockYears + m_BlockYears - 1;
+}
+template <class Holidays, class Storage>
+std::size_t AdaptiveHolidayCalendar<Holidays, Storage>::MemoryUsage() const
+{
+    return m_Calendar.MemoryUsage();
+}
+template <class Holidays, class Storage>
+int AdaptiveHolidayCalendar<Holidays, Storage>::BlockOf(int year) const
+{
+    // round towards negative infinity so every block holds blockYears
+    return year >= 0 ? year / m_BlockYears : -((-year - 1) / m_BlockYears) - 1;
+}
+template <class Holidays, class Storage>
+void AdaptiveHolidayCalendar<Holidays, Storage>::Record(const Date& date)
+{
+    if (date.Valid())
+    {
+        int block = BlockOf(date.Year());
+        if (block >= m_StartBlock && block <= m_EndBlock)
+        {
+            ++m_CachedHits[block - m_StartBlock];
+        }
+        else
+        {
+            ++m_UncachedHits[block];
+        }
+    }
+    if (++m_Queries >= m_Window) Adapt();
+}
+template <class Holidays, class Storage>
+void AdaptiveHolidayCalendar<Holidays, Storage>::Adapt()
+{
+    std::map<int, unsigned> hits;
+    hits.swap(m_UncachedHits);
+    for (std::size_t i = 0; i < m_CachedHits.size(); ++i)
+    {
+        if (m_CachedHits[i] != 0) hits[m_StartBlock + static_cast<int>(i)] += m_CachedHits[i];
+    }
+    if (m_MaxBlocks < 0) m_MaxBlocks = BlocksInBudget();
+    // find the contiguous run of at most maxBlocks blocks with the most hits
+    int maxBlocks = m_MaxBlocks;
+    int bestStart = 0;
+    int bestEnd = -1;
+    unsigned long bestHits = 0;
+    unsigned long runHits = 0;
+    std::map<int, unsigned>::const_iterator first = hits.begin();
+    std::map<int, unsigned>::const_iterator last = hits.begin();
+    for (; maxBlocks > 0 && last != hits.end(); ++last)
+    {
+        runHits += last->second;
+        while (last->first - first->first >= maxBlocks)
+        {
+            runHits -= first->second;
+            ++first;
+        }
+        if (runHits > bestHits)
+        {
+            bestHits = runHits;
+            bestStart = first->first;
+            bestEnd = last->first;
+        }
+    }
+    if (bestStart != m_StartBlock || bestEnd != m_EndBlock)
+    {
+        Rebuild(bestStart, bestEnd);
+    }
+    m_CachedHits.assign(m_EndBlock >= m_StartBlock ? m_EndBlock - m_StartBlock + 1 : 0, 0);
+    m_Queries = 0;
+}
+template <class Holidays, class Storage>
+int AdaptiveHolidayCalendar<Holidays, Storage>::BlocksInBudget() const
+{
+    // the storage policies grow linearly with the cached years, so a run
+    // of blocks takes at most as many bytes per block as a single block
+    HolidayCalendar<Holidays, Storage> block(0, m_BlockYears - 1);
+    std::size_t bytesPerBlock = std::max<std::size_t>(block.MemoryUsage(), 1);
+    std::size_t blocks = m_MemoryBudget / bytesPerBlock;
+    return static_cast<int>(std::min<std::size_t>(blocks, std::numeric_limits<int>::max()));
+}
+template <class Holidays, class Storage>
+void AdaptiveHolidayCalendar<Holidays, Storage>::Rebuild(int startBlock, int endBlock)
+{
+    if (endBlock >= startBlock)
+    {
+        m_Calendar.Cache(startBlock * m_BlockYears, endBlock * m_BlockYears + m_BlockYears - 1);
+        if (m_Calendar.MemoryUsage() > m_MemoryBudget)
+        {
+            // a storage policy growing faster than linearly: drop the
+            // cache and try one block fewer in the next window
+            m_MaxBlocks = endBlock - startBlock;
+            endBlock = startBlock - 1;
+        }
+    }
+    if (endBlock < startBlock)
+    {
+        m_Calendar.Cache(0, -1);
+        startBlock = 0;
+        endBlock = -1;
+    }
+    m_StartBlock = startBlock;
+    m_EndBlock = endBlock;
+}
+
+} // namespace Holiday
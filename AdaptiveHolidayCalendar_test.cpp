@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "AdaptiveHolidayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include "KnownUSMarketHolidays.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace Holiday;
+
+TEST(AdaptiveHolidayCalendar, KnownUSMarketHolidays)
+{
+    AdaptiveHolidayCalendar<USMarketHolidays> calendar(1024, 100, 4);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+        {
+            int yyyymmdd = date;
+            bool isKnownHoliday = std::find(std::begin(KnownUSMarketHolidays),
+                                            std::end(KnownUSMarketHolidays),
+                                            yyyymmdd) != std::end(KnownUSMarketHolidays);
+            EXPECT_EQ(isKnownHoliday, calendar.IsMarketHoliday(date)) << yyyymmdd;
+            EXPECT_LE(calendar.MemoryUsage(), 1024u);
+        }
+    }
+}
+
+TEST(AdaptiveHolidayCalendar, CachesHotYears)
+{
+    // a window long enough to see the whole scan
+    AdaptiveHolidayCalendar<USMarketHolidays> calendar(1 << 20, 4000, 8);
+    EXPECT_GT(calendar.StartYear(), calendar.EndYear());
+    EXPECT_EQ(0u, calendar.MemoryUsage());
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for(Date date(2010,1,1); date.Year() <= 2020; date = date.GetNextDay())
+        {
+            calendar.IsMarketHoliday(date);
+        }
+    }
+    EXPECT_LE(calendar.StartYear(), 2010);
+    EXPECT_GE(calendar.EndYear(), 2020);
+    EXPECT_GT(calendar.MemoryUsage(), 0u);
+}
+
+TEST(AdaptiveHolidayCalendar, FollowsHotRegion)
+{
+    AdaptiveHolidayCalendar<USMarketHolidays> calendar(1 << 20, 1000, 8);
+    for(Date date(2010,1,1); date.Year() <= 2012; date = date.GetNextDay())
+    {
+        calendar.IsMarketHoliday(date);
+    }
+    EXPECT_LE(calendar.StartYear(), 2010);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for(Date date(1900,1,1); date.Year() <= 1902; date = date.GetNextDay())
+        {
+            calendar.IsMarketHoliday(date);
+        }
+    }
+    EXPECT_LE(calendar.StartYear(), 1900);
+    EXPECT_GE(calendar.EndYear(), 1902);
+    EXPECT_LT(calendar.EndYear(), 2010);
+}
+
+TEST(AdaptiveHolidayCalendar, RespectsBudget)
+{
+    // roughly enough for a few blocks of sorted storage
+    const std::size_t budget = 200;
+    AdaptiveHolidayCalendar<USMarketHolidays> calendar(budget, 500, 4);
+    for(Date date(1950,1,1); date.Year() <= 2050; date = date.GetNextDay())
+    {
+        calendar.IsMarketHoliday(date);
+        ASSERT_LE(calendar.MemoryUsage(), budget);
+    }
+    EXPECT_GT(calendar.MemoryUsage(), 0u);
+    EXPECT_LT(calendar.EndYear() - calendar.StartYear(), 40);
+}
+
+TEST(AdaptiveHolidayCalendar, NothingFits)
+{
+    AdaptiveHolidayCalendar<USMarketHolidays, HashHolidayStorage> calendar(16, 100, 8);
+    for(Date date(2010,1,1); date.Year() <= 2012; date = date.GetNextDay())
+    {
+        calendar.IsMarketHoliday(date);
+        ASSERT_LE(calendar.MemoryUsage(), 16u);
+    }
+    EXPECT_GT(calendar.StartYear(), calendar.EndYear());
+}
+
+TEST(AdaptiveHolidayCalendar, WideSpreadSmallBudget)
+{
+    // every block of the window is hit, far more than fit in the budget
+    const std::size_t budget = 4096;
+    std::mt19937 generator(42);
+    const int spreads[][2] = { { 1000, 3000 }, { 0, 20000 } };
+    for (std::size_t s = 0; s < sizeof(spreads) / sizeof(spreads[0]); ++s)
+    {
+        AdaptiveHolidayCalendar<USMarketHolidays> calendar(budget);
+        AdaptiveHolidayCalendar<USMarketHolidays, HashHolidayStorage> hashCalendar(budget);
+        std::uniform_int_distribution<int> years(spreads[s][0], spreads[s][1]);
+        for (int i = 0; i < 3 * 4096; ++i)
+        {
+            Date date(years(generator), 12, 25);
+            EXPECT_EQ(USMarketHolidays::IsMarketHoliday(date), calendar.IsMarketHoliday(date));
+            EXPECT_EQ(USMarketHolidays::IsMarketHoliday(date), hashCalendar.IsMarketHoliday(date));
+            ASSERT_LE(calendar.MemoryUsage(), budget);
+            ASSERT_LE(hashCalendar.MemoryUsage(), budget);
+        }
+        EXPECT_GT(calendar.MemoryUsage(), 0u);
+        EXPECT_LE(calendar.StartYear(), calendar.EndYear());
+    }
+}
@@ -0,0 +1,95 @@
+/// @file
+/// @brief Defines Holiday::Arena and Holiday::ArenaAllocator which place
+///        calendar storage in a caller-provided block of memory, e.g. one
+///        that has been pre-faulted or is backed by huge pages.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Holiday
+{
+
+/// @brief Hands out memory from a caller-provided block by bumping an
+///        offset.  Memory is only reclaimed when the whole arena is
+///        discarded, so it suits calendars that are built once and kept.
+///        An arena is not thread safe; build calendars using the same
+///        arena from one thread at a time.
+class Arena
+{
+public:
+    /// @brief Creates an arena over memory, which must outlive the arena
+    ///        and every container allocating from it
+    inline Arena(void* memory, std::size_t size);
+    /// @brief Returns size bytes aligned to alignment
+    /// @throw std::bad_alloc when the arena is exhausted
+    inline void* Allocate(std::size_t size, std::size_t alignment);
+    /// @brief Number of bytes handed out, including alignment padding
+    inline std::size_t Used() const;
+    /// @brief Total number of bytes in the arena
+    inline std::size_t Size() const;
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+    char* m_Memory;
+    std::size_t m_Size;
+    std::size_t m_Used;
+};
+
+/// @brief Standard allocator handing out memory from an Arena.
+///        Deallocation is a no-op.
+template <class T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    ArenaAllocator(Arena& arena) : m_Arena(&arena) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : m_Arena(other.GetArena()) {}
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_Arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, std::size_t) {}
+    Arena* GetArena() const { return m_Arena; }
+private:
+    Arena* m_Arena;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return lhs.GetArena() == rhs.GetArena();
+}
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return lhs.GetArena() != rhs.GetArena();
+}
+
+Arena::Arena(void* memory, std::size_t size)
+{
+    m_Memory = static_cast<char*>(memory);
+    m_Size = size;
+    m_Used = 0;
+}
+void* Arena::Allocate(std::size_t size, std::size_t alignment)
+{
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_Memory + m_Used);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+    if (padding > m_Size - m_Used || size > m_Size - m_Used - padding) throw std::bad_alloc();
+    void* memory = m_Memory + m_Used + padding;
+    m_Used += padding + size;
+    return memory;
+}
+std::size_t Arena::Used() const
+{
+    return m_Used;
+}
+std::size_t Arena::Size() const
+{
+    return m_Size;
+}
+
+} // namespace Holiday
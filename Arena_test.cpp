@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "Arena.hpp"
+#include "HolidayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+std::size_t g_Allocations = 0;
+
+/// Standard allocator counting the number of allocations made through it
+template <class T>
+class CountingAllocator : public std::allocator<T>
+{
+public:
+    typedef T value_type;
+    template <class U> struct rebind { typedef CountingAllocator<U> other; };
+    CountingAllocator() {}
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+    T* allocate(std::size_t n)
+    {
+        ++g_Allocations;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+} // namespace
+
+TEST(Arena, AllocatesAlignedUntilExhausted)
+{
+    alignas(8) char memory[64];
+    Arena arena(memory, sizeof(memory));
+    void* first = arena.Allocate(1, 1);
+    EXPECT_EQ(memory, first);
+    void* second = arena.Allocate(8, 8);
+    EXPECT_EQ(memory + 8, second);
+    EXPECT_EQ(16u, arena.Used());
+    EXPECT_EQ(64u, arena.Size());
+    EXPECT_THROW(arena.Allocate(64, 1), std::bad_alloc);
+    arena.Allocate(48, 1);
+    EXPECT_EQ(64u, arena.Used());
+    EXPECT_THROW(arena.Allocate(1, 1), std::bad_alloc);
+}
+
+TEST(Arena, CalendarsInArena)
+{
+    std::vector<char> memory(1 << 16);
+    Arena arena(memory.data(), memory.size());
+    HolidayCalendar<USMarketHolidays, BasicSortedHolidayStorage<ArenaAllocator<std::uint16_t> > >
+        holidays(1990, 2050, BasicSortedHolidayStorage<ArenaAllocator<std::uint16_t> >(arena));
+    TradingDayCalendar<USMarketHolidays, SaturdaySundayWeekend, ArenaAllocator<std::uint64_t> >
+        tradingDays(1990, 2050, arena);
+    EXPECT_GT(arena.Used(), 0u);
+    EXPECT_LE(arena.Used(), arena.Size());
+
+    TradingDayCalendar<USMarketHolidays> reference;
+    for(Date date(1990,1,1); date.Year() <= 2050; date = date.GetNextDay())
+    {
+        EXPECT_EQ(USMarketHolidays::IsMarketHoliday(date), holidays.IsMarketHoliday(date)) << int(date);
+        EXPECT_EQ(reference.IsTradingDay(date), tradingDays.IsTradingDay(date)) << int(date);
+    }
+}
+
+TEST(Arena, CacheAllocationsDoNotGrowWithRange)
+{
+    typedef BasicSortedHolidayStorage<CountingAllocator<std::uint16_t> > Storage_t;
+    HolidayCalendar<USMarketHolidays, Storage_t> holidays;
+    TradingDayCalendar<USMarketHolidays, SaturdaySundayWeekend, CountingAllocator<std::uint64_t> > tradingDays;
+
+    g_Allocations = 0;
+    holidays.Cache(2000, 2001);
+    std::size_t narrow = g_Allocations;
+    g_Allocations = 0;
+    holidays.Cache(1900, 2100);
+    EXPECT_EQ(narrow, g_Allocations);
+
+    g_Allocations = 0;
+    tradingDays.Cache(1900, 2100);
+    // the bitmap, its ranks and its select samples
+    EXPECT_EQ(3u, g_Allocations);
+}
+
+TEST(Arena, MovesDoNotAllocate)
+{
+    typedef BasicSortedHolidayStorage<CountingAllocator<std::uint16_t> > Storage_t;
+    typedef HolidayCalendar<USMarketHolidays, Storage_t> Holidays_t;
+    typedef TradingDayCalendar<USMarketHolidays, SaturdaySundayWeekend, CountingAllocator<std::uint64_t> > TradingDays_t;
+    Holidays_t holidays(2000, 2030);
+    TradingDays_t tradingDays(2000, 2030);
+
+    g_Allocations = 0;
+    Holidays_t movedHolidays(std::move(holidays));
+    TradingDays_t movedTradingDays(std::move(tradingDays));
+    holidays = std::move(movedHolidays);
+    tradingDays = std::move(movedTradingDays);
+    EXPECT_EQ(0u, g_Allocations);
+    EXPECT_TRUE(holidays.IsMarketHoliday(2020,12,25));
+    EXPECT_FALSE(tradingDays.IsTradingDay(2020,12,25));
+
+    Holidays_t copiedHolidays(holidays);
+    EXPECT_GT(g_Allocations, 0u);
+    EXPECT_TRUE(copiedHolidays.IsMarketHoliday(2020,12,25));
+}
@@ -0,0 +1,188 @@
+/// @file
+/// @brief Defines Holiday::AsyncTradingDayCalendar, a trading day calendar
+///        that starts answering queries while most of its cache is still
+///        being built in the background.
+#pragma once
+
+#include "Date.hpp"
+#include "Weekend.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief A trading day calendar whose cache is loaded a year at a time.
+///
+///        The constructor caches the near-term years before returning and
+///        loads the remaining years on a background thread, nearest to the
+///        near-term years first.  Each year has its own bitmap words and a
+///        loaded flag that is published after its words are written, so a
+///        query reads either a complete year or, for a year not loaded yet,
+///        falls back to evaluating the Holidays and Weekend rules.  Queries
+///        never block and never see a partially written year.
+///
+///        The destructor stops the background loading and waits for it.
+template <class Holidays, class Weekend = SaturdaySundayWeekend>
+class AsyncTradingDayCalendar
+{
+public:
+    /// @brief Caches nearStartYear to nearEndYear, clamped to startYear
+    ///        and endYear, then returns while the other years between
+    ///        startYear and endYear are loaded in the background.  An empty
+    ///        near-term range loads every year in the background.
+    AsyncTradingDayCalendar(int startYear, int endYear, int nearStartYear, int nearEndYear);
+    ~AsyncTradingDayCalendar();
+    /// @brief Returns true if the provided date is a Trading Day
+    bool IsTradingDay(int year, int month, int day) const;
+    /// @brief Returns true if the provided date is a Trading Day
+    bool IsTradingDay(int yyyymmdd) const;
+    /// @brief Returns true if the provided date is a Trading Day
+    bool IsTradingDay(const Date& date) const;
+    /// @brief Returns the first Trading Day after the provided date, or an
+    ///        invalid date if the provided date is invalid or every day of
+    ///        the week is a weekend day
+    Date GetNextTradingDay(const Date& date) const;
+    /// @brief Returns true once the year's trading days are cached
+    bool IsLoaded(int year) const;
+    /// @brief Becomes ready once every year is cached, e.g. to await the
+    ///        end of warm-up.  get() rethrows an exception from loading.
+    std::shared_future<void> Loaded() const;
+    /// @brief Blocks until every year is cached
+    void Wait() const;
+    /// @brief Approximate number of bytes allocated by the cache
+    std::size_t MemoryUsage() const;
+private:
+    AsyncTradingDayCalendar(const AsyncTradingDayCalendar&);
+    AsyncTradingDayCalendar& operator=(const AsyncTradingDayCalendar&);
+    /// enough 64-bit words for the 366 days of a leap year
+    static const int WordsPerYear = 6;
+    bool IsTradingDayNoCache(const Date& date) const;
+    void LoadYear(int year);
+    void LoadRemaining(int nearStartYear, int nearEndYear);
+    int m_StartYear;
+    int m_EndYear;
+    std::vector<std::uint64_t> m_TradingDays;
+    std::unique_ptr<std::atomic<bool>[]> m_Loaded;
+    std::atomic<bool> m_Stop;
+    std::shared_future<void> m_Loading;
+};
+
+template <class Holidays, class Weekend>
+AsyncTradingDayCalendar<Holidays, Weekend>::AsyncTradingDayCalendar(int startYear, int endYear,
+                                                                    int nearStartYear, int nearEndYear)
+{
+    m_StartYear = startYear;
+    m_EndYear = endYear;
+    std::size_t years = startYear <= endYear ? endYear - startYear + 1 : 0;
+    m_TradingDays.assign(years * WordsPerYear, 0);
+    m_Loaded.reset(new std::atomic<bool>[years]());
+    m_Stop = false;
+    if (nearStartYear < startYear) nearStartYear = startYear;
+    if (nearEndYear > endYear) nearEndYear = endYear;
+    for (int year = nearStartYear; year <= nearEndYear; ++year)
+    {
+        LoadYear(year);
+    }
+    m_Loading = std::async(std::launch::async, &AsyncTradingDayCalendar::LoadRemaining,
+                           this, nearStartYear, nearEndYear).share();
+}
+template <class Holidays, class Weekend>
+AsyncTradingDayCalendar<Holidays, Weekend>::~AsyncTradingDayCalendar()
+{
+    m_Stop = true;
+    m_Loading.wait();
+}
+template <class Holidays, class Weekend>
+void AsyncTradingDayCalendar<Holidays, Weekend>::LoadYear(int year)
+{
+    std::size_t index = year - m_StartYear;
+    std::uint64_t* words = &m_TradingDays[index * WordsPerYear];
+    std::size_t day = 0;
+    for (Date date(year,1,1); date.Year() == year; date = date.GetNextDay(), ++day)
+    {
+        if (IsTradingDayNoCache(date))
+        {
+            words[day / 64] |= std::uint64_t(1) << (day % 64);
+        }
+    }
+    // publishes the words written above to queries that see the flag
+    m_Loaded[index].store(true, std::memory_order_release);
+}
+template <class Holidays, class Weekend>
+void AsyncTradingDayCalendar<Holidays, Weekend>::LoadRemaining(int nearStartYear, int nearEndYear)
+{
+    if (nearStartYear > nearEndYear)
+    {
+        // nothing loaded yet, so start from the beginning
+        nearStartYear = m_StartYear;
+        nearEndYear = m_StartYear - 1;
+    }
+    // alternate between the years after and before the near-term range
+    int after = nearEndYear + 1;
+    int before = nearStartYear - 1;
+    while (!m_Stop && (after <= m_EndYear || before >= m_StartYear))
+    {
+        if (after <= m_EndYear) LoadYear(after++);
+        if (before >= m_StartYear && !m_Stop) LoadYear(before--);
+    }
+}
+template <class Holidays, class Weekend>
+bool AsyncTradingDayCalendar<Holidays, Weekend>::IsTradingDayNoCache(const Date& date) const
+{
+    return date.Valid() && !(Holidays::IsMarketHoliday(date) || Weekend::IsWeekend(date));
+}
+template <class Holidays, class Weekend>
+bool AsyncTradingDayCalendar<Holidays, Weekend>::IsLoaded(int year) const
+{
+    return year >= m_StartYear && year <= m_EndYear
+        && m_Loaded[year - m_StartYear].load(std::memory_order_acquire);
+}
+template <class Holidays, class Weekend>
+bool AsyncTradingDayCalendar<Holidays, Weekend>::IsTradingDay(int year, int month, int day) const
+{
+    return IsTradingDay(Date(year, month, day));
+}
+template <class Holidays, class Weekend>
+bool AsyncTradingDayCalendar<Holidays, Weekend>::IsTradingDay(int yyyymmdd) const
+{
+    return IsTradingDay(Date(yyyymmdd));
+}
+template <class Holidays, class Weekend>
+bool AsyncTradingDayCalendar<Holidays, Weekend>::IsTradingDay(const Date& date) const
+{
+    if (!date.Valid() || !IsLoaded(date.Year())) return IsTradingDayNoCache(date);
+    std::size_t day = date.DayOfYear() - 1;
+    std::uint64_t word = m_TradingDays[(date.Year() - m_StartYear) * WordsPerYear + day / 64];
+    return ((word >> (day % 64)) & 1u) != 0;
+}
+template <class Holidays, class Weekend>
+Date AsyncTradingDayCalendar<Holidays, Weekend>::GetNextTradingDay(const Date& date) const
+{
+    if (!date.Valid() || Weekend::Mask == WeekdayMask::All) return Date();
+    Date next = date.GetNextDay();
+    while (!IsTradingDay(next)) next = next.GetNextDay();
+    return next;
+}
+template <class Holidays, class Weekend>
+std::shared_future<void> AsyncTradingDayCalendar<Holidays, Weekend>::Loaded() const
+{
+    return m_Loading;
+}
+template <class Holidays, class Weekend>
+void AsyncTradingDayCalendar<Holidays, Weekend>::Wait() const
+{
+    m_Loading.get();
+}
+template <class Holidays, class Weekend>
+std::size_t AsyncTradingDayCalendar<Holidays, Weekend>::MemoryUsage() const
+{
+    std::size_t years = m_TradingDays.size() / WordsPerYear;
+    return m_TradingDays.capacity() * sizeof(std::uint64_t) + years * sizeof(std::atomic<bool>);
+}
+
+} // namespace Holiday
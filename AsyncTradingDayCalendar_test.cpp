@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "AsyncTradingDayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <thread>
+#include <vector>
+
+using namespace Holiday;
+
+TEST(AsyncTradingDayCalendar, NearTermYearsLoadedOnReturn)
+{
+    AsyncTradingDayCalendar<USMarketHolidays> calendar(1900, 2100, 2020, 2021);
+    EXPECT_TRUE(calendar.IsLoaded(2020));
+    EXPECT_TRUE(calendar.IsLoaded(2021));
+    EXPECT_FALSE(calendar.IsLoaded(1899));
+    EXPECT_FALSE(calendar.IsLoaded(2101));
+    EXPECT_FALSE(calendar.IsTradingDay(20201225));
+    EXPECT_TRUE(calendar.IsTradingDay(20201224));
+    EXPECT_LE(201u * 6 * sizeof(std::uint64_t), calendar.MemoryUsage());
+    calendar.Wait();
+    for (int year = 1900; year <= 2100; ++year)
+    {
+        EXPECT_TRUE(calendar.IsLoaded(year)) << year;
+    }
+}
+
+TEST(AsyncTradingDayCalendar, AgreesWithTradingDayCalendarWhileLoading)
+{
+    TradingDayCalendar<USMarketHolidays> reference;
+    AsyncTradingDayCalendar<USMarketHolidays> calendar(1950, 2050, 2020, 2020);
+    std::vector<std::thread> readers;
+    std::vector<int> failures(4, 0);
+    for (std::size_t i = 0; i < failures.size(); ++i)
+    {
+        readers.push_back(std::thread([&reference, &calendar, &failures, i]()
+        {
+            for (Date date(1940,1,1); date.Year() <= 2060; date = date.GetNextDay())
+            {
+                if (calendar.IsTradingDay(date) != reference.IsTradingDay(date)) ++failures[i];
+            }
+        }));
+    }
+    for (std::size_t i = 0; i < readers.size(); ++i)
+    {
+        readers[i].join();
+        EXPECT_EQ(0, failures[i]);
+    }
+    calendar.Loaded().get();
+    for (Date date(1940,1,1); date.Year() <= 2060; date = date.GetNextDay())
+    {
+        EXPECT_EQ(reference.IsTradingDay(date), calendar.IsTradingDay(date)) << int(date);
+    }
+    EXPECT_EQ(20200102, calendar.GetNextTradingDay(Date(20191231)));
+    EXPECT_EQ(20210104, calendar.GetNextTradingDay(Date(20201231)));
+    EXPECT_FALSE(calendar.GetNextTradingDay(Date(20201301)).Valid());
+    EXPECT_FALSE(calendar.IsTradingDay(20201301));
+}
+
+TEST(AsyncTradingDayCalendar, EmptyNearTermRange)
+{
+    AsyncTradingDayCalendar<USMarketHolidays> calendar(2000, 2010, 1, 0);
+    calendar.Wait();
+    EXPECT_TRUE(calendar.IsLoaded(2000));
+    EXPECT_TRUE(calendar.IsLoaded(2010));
+    EXPECT_FALSE(calendar.IsTradingDay(20100101));
+}
+
+TEST(AsyncTradingDayCalendar, DestroyedWhileLoading)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        AsyncTradingDayCalendar<USMarketHolidays> calendar(1600, 2400, 2020, 2020);
+        EXPECT_TRUE(calendar.IsTradingDay(20200102));
+    }
+}
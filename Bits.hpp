@@ -0,0 +1,41 @@
+/// @file
+/// @brief Bit operations on the 64-bit words of the trading day bitmaps
+#pragma once
+
+#include <cstdint>
+
+namespace Holiday
+{
+
+/// @brief Number of set bits in word
+inline int PopCount(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/// @brief Position of the set bit of word with rank set bits below it,
+///        which must be less than PopCount(word)
+inline int SelectBit(std::uint64_t word, int rank)
+{
+    // skip whole bytes, then the bits of the byte holding the set bit
+    int bit = 0;
+    for (int count = PopCount(word & 0xff); rank >= count; count = PopCount(word & 0xff))
+    {
+        rank -= count;
+        word >>= 8;
+        bit += 8;
+    }
+    for (;; ++bit, word >>= 1)
+    {
+        if ((word & 1u) != 0 && rank-- == 0) return bit;
+    }
+}
+
+} // namespace Holiday
@@ -0,0 +1,249 @@
+/// @file
+/// @brief Defines Holiday::CalendarAnnotator which streams delimited text
+///        rows beginning with a yyyymmdd date and appends is-holiday,
+///        is-trading-day and next-trading-day columns to each row.
+#pragma once
+
+#include "Date.hpp"
+#include "HolidayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief Annotates rows of a text stream with calendar columns.
+///
+///        Input is read in chunks into a fixed-size buffer.  The dates of up
+///        to BatchRows complete rows are parsed into an array and annotated
+///        with the batch queries of the calendars, then each row is copied
+///        with its annotation into a fixed-size output buffer that is
+///        written out when full, so memory use is bounded by the buffer
+///        size regardless of the stream length.
+///
+///        Each row must begin with a yyyymmdd date followed by the delimiter
+///        or the end of the row.  A first row whose first field has other
+///        characters than digits is treated as a header and gets the column
+///        names appended; any other row without a valid date gets empty
+///        columns.
+template <class Holidays>
+class CalendarAnnotator
+{
+public:
+    /// @brief Creates an annotator using the provided calendars, which
+    ///        must outlive the annotator
+    CalendarAnnotator(const HolidayCalendar<Holidays>& holidays,
+                      const TradingDayCalendar<Holidays>& tradingDays,
+                      char delimiter = ',',
+                      std::size_t bufferSize = 1 << 20);
+    /// @brief Annotates every row of input and writes it to output
+    /// @return false on a read or write error, or if a row does not fit
+    ///         in the buffer
+    bool Annotate(std::FILE* input, std::FILE* output);
+private:
+    static const std::size_t MaxAnnotationSize = 64;
+    /// rows whose dates are queried together
+    static const std::size_t BatchRows = 256;
+    /// date of a header row
+    static const int HeaderDate = -2;
+    struct Row
+    {
+        const char* begin;
+        std::size_t length;
+        bool newline;
+    };
+    void AddRow(const char* row, std::size_t length, bool newline);
+    void AnnotateRows();
+    void WriteRow(const Row& row);
+    void SetAnnotation(int yyyymmdd, bool holiday, bool tradingDay, int next);
+    void Flush();
+    int ParseDate(const char* row, std::size_t length) const;
+    bool IsNumericField(const char* row, std::size_t length) const;
+    const HolidayCalendar<Holidays>& m_Holidays;
+    const TradingDayCalendar<Holidays>& m_TradingDays;
+    char m_Delimiter;
+    std::vector<char> m_Input;
+    std::vector<char> m_Output;
+    std::size_t m_OutputSize;
+    std::FILE* m_OutputFile;
+    bool m_WriteFailed;
+    bool m_FirstRow;
+    Row m_Rows[BatchRows];
+    int m_Dates[BatchRows];
+    std::size_t m_RowCount;
+    char m_Annotation[MaxAnnotationSize];
+    std::size_t m_AnnotationSize;
+};
+
+template <class Holidays>
+CalendarAnnotator<Holidays>::CalendarAnnotator(const HolidayCalendar<Holidays>& holidays,
+                                               const TradingDayCalendar<Holidays>& tradingDays,
+                                               char delimiter,
+                                               std::size_t bufferSize)
+    : m_Holidays(holidays)
+    , m_TradingDays(tradingDays)
+    , m_Delimiter(delimiter)
+    , m_Input(bufferSize < MaxAnnotationSize ? MaxAnnotationSize : bufferSize)
+    , m_Output(m_Input.size() + MaxAnnotationSize + 2)
+{
+}
+template <class Holidays>
+bool CalendarAnnotator<Holidays>::Annotate(std::FILE* input, std::FILE* output)
+{
+    m_OutputSize = 0;
+    m_OutputFile = output;
+    m_WriteFailed = false;
+    m_FirstRow = true;
+    m_RowCount = 0;
+    m_AnnotationSize = 0;
+    std::size_t filled = 0;
+    for (;;)
+    {
+        std::size_t count = std::fread(&m_Input[filled], 1, m_Input.size() - filled, input);
+        if (count == 0 && std::ferror(input)) return false;
+        filled += count;
+        const char* begin = m_Input.data();
+        const char* end = begin + filled;
+        const char* newline;
+        while ((newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin))) != NULL)
+        {
+            AddRow(begin, newline - begin, true);
+            begin = newline + 1;
+        }
+        if (count == 0)
+        {
+            if (begin != end) AddRow(begin, end - begin, false);
+            break;
+        }
+        filled = end - begin;
+        if (filled == m_Input.size())
+        {
+            // a full buffer without a newline is a row only if the row or
+            // the input ends right after it
+            int c = std::fgetc(input);
+            if (c == EOF && std::ferror(input)) return false;
+            if (c != '\n' && c != EOF) return false; // row longer than the buffer
+            AddRow(begin, filled, c == '\n');
+            if (c == EOF) break;
+            filled = 0;
+        }
+        // the queued rows point into the input buffer
+        AnnotateRows();
+        std::memmove(m_Input.data(), begin, filled);
+    }
+    AnnotateRows();
+    Flush();
+    return !m_WriteFailed && std::fflush(output) == 0;
+}
+template <class Holidays>
+void CalendarAnnotator<Holidays>::AddRow(const char* row, std::size_t length, bool newline)
+{
+    // a DOS line ending is kept after the appended columns
+    std::size_t content = (length != 0 && row[length - 1] == '\r') ? length - 1 : length;
+    int yyyymmdd = ParseDate(row, content);
+    if (m_FirstRow && yyyymmdd < 0 && !IsNumericField(row, content)) yyyymmdd = HeaderDate;
+    m_FirstRow = false;
+    Row& queued = m_Rows[m_RowCount];
+    queued.begin = row;
+    queued.length = length;
+    queued.newline = newline;
+    m_Dates[m_RowCount] = yyyymmdd;
+    if (++m_RowCount == BatchRows) AnnotateRows();
+}
+template <class Holidays>
+void CalendarAnnotator<Holidays>::AnnotateRows()
+{
+    bool holidays[BatchRows];
+    bool tradingDays[BatchRows];
+    int next[BatchRows];
+    m_Holidays.IsMarketHoliday(m_Dates, m_RowCount, holidays);
+    m_TradingDays.IsTradingDay(m_Dates, m_RowCount, tradingDays);
+    m_TradingDays.GetNextTradingDay(m_Dates, m_RowCount, next);
+    for (std::size_t i = 0; i < m_RowCount; ++i)
+    {
+        SetAnnotation(m_Dates[i], holidays[i], tradingDays[i], next[i]);
+        WriteRow(m_Rows[i]);
+    }
+    m_RowCount = 0;
+}
+template <class Holidays>
+void CalendarAnnotator<Holidays>::WriteRow(const Row& row)
+{
+    std::size_t length = row.length;
+    std::size_t content = (length != 0 && row.begin[length - 1] == '\r') ? length - 1 : length;
+    if (m_Output.size() - m_OutputSize < length + m_AnnotationSize + 1) Flush();
+    char* out = m_Output.data() + m_OutputSize;
+    std::memcpy(out, row.begin, content);
+    out += content;
+    std::memcpy(out, m_Annotation, m_AnnotationSize);
+    out += m_AnnotationSize;
+    if (content != length) *out++ = '\r';
+    if (row.newline) *out++ = '\n';
+    m_OutputSize = out - m_Output.data();
+}
+template <class Holidays>
+void CalendarAnnotator<Holidays>::SetAnnotation(int yyyymmdd, bool holiday, bool tradingDay, int next)
+{
+    if (yyyymmdd == HeaderDate)
+    {
+        m_AnnotationSize = std::sprintf(m_Annotation, "%cis_holiday%cis_trading_day%cnext_trading_day",
+                                        m_Delimiter, m_Delimiter, m_Delimiter);
+        return;
+    }
+    char* out = m_Annotation;
+    *out++ = m_Delimiter;
+    if (yyyymmdd >= 0)
+    {
+        *out++ = holiday ? '1' : '0';
+        *out++ = m_Delimiter;
+        *out++ = tradingDay ? '1' : '0';
+        *out++ = m_Delimiter;
+        for (int i = 7; i >= 0; --i, next /= 10) out[i] = static_cast<char>('0' + next % 10);
+        out += 8;
+    }
+    else
+    {
+        *out++ = m_Delimiter;
+        *out++ = m_Delimiter;
+    }
+    m_AnnotationSize = out - m_Annotation;
+}
+template <class Holidays>
+void CalendarAnnotator<Holidays>::Flush()
+{
+    if (m_OutputSize != 0
+        && std::fwrite(m_Output.data(), 1, m_OutputSize, m_OutputFile) != m_OutputSize)
+    {
+        m_WriteFailed = true;
+    }
+    m_OutputSize = 0;
+}
+template <class Holidays>
+int CalendarAnnotator<Holidays>::ParseDate(const char* row, std::size_t length) const
+{
+    // returns -1 unless the row starts with a valid date in years 1000-9998
+    // so that the next trading day also fits in eight digits
+    if (length < 8 || (length > 8 && row[8] != m_Delimiter)) return -1;
+    int yyyymmdd = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        unsigned digit = static_cast<unsigned>(row[i] - '0');
+        if (digit > 9) return -1;
+        yyyymmdd = yyyymmdd * 10 + static_cast<int>(digit);
+    }
+    return (yyyymmdd >= 10000000 && yyyymmdd < 99990000 && Date(yyyymmdd).Valid()) ? yyyymmdd : -1;
+}
+template <class Holidays>
+bool CalendarAnnotator<Holidays>::IsNumericField(const char* row, std::size_t length) const
+{
+    for (std::size_t i = 0; i < length && row[i] != m_Delimiter; ++i)
+    {
+        if (row[i] < '0' || row[i] > '9') return false;
+    }
+    return true;
+}
+
+} // namespace Holiday
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "CalendarAnnotator.hpp"
+#include "USMarketHolidays.hpp"
+#include <cstdio>
+#include <string>
+
+using namespace Holiday;
+
+namespace
+{
+
+std::string Annotate(const std::string& text, char delimiter = ',', std::size_t bufferSize = 1 << 20)
+{
+    HolidayCalendar<USMarketHolidays> holidays(2010, 2020);
+    TradingDayCalendar<USMarketHolidays> tradingDays(2010, 2020);
+    CalendarAnnotator<USMarketHolidays> annotator(holidays, tradingDays, delimiter, bufferSize);
+    std::FILE* input = std::tmpfile();
+    std::FILE* output = std::tmpfile();
+    std::fwrite(text.data(), 1, text.size(), input);
+    std::rewind(input);
+    bool ok = annotator.Annotate(input, output);
+    std::string result;
+    if (ok)
+    {
+        std::rewind(output);
+        char buffer[256];
+        std::size_t count;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), output)) != 0)
+        {
+            result.append(buffer, count);
+        }
+    }
+    std::fclose(input);
+    std::fclose(output);
+    return ok ? result : "failed";
+}
+
+} // namespace
+
+TEST(CalendarAnnotator, Rows)
+{
+    EXPECT_EQ("20200217,1,0,20200218\n"
+              "20200218,0,1,20200219\n"
+              "20200409,0,1,20200413\n",
+              Annotate("20200217\n20200218\n20200409\n"));
+}
+
+TEST(CalendarAnnotator, HeaderAndExtraColumns)
+{
+    EXPECT_EQ("date,price,is_holiday,is_trading_day,next_trading_day\n"
+              "20200217,1.5,1,0,20200218\n"
+              "20200217,1.6,1,0,20200218\n",
+              Annotate("date,price\n20200217,1.5\n20200217,1.6\n"));
+}
+
+TEST(CalendarAnnotator, InvalidFirstRowIsNotHeader)
+{
+    EXPECT_EQ("20200230,4,,,\n"
+              "20200217,5,1,0,20200218\n",
+              Annotate("20200230,4\n20200217,5\n"));
+    EXPECT_EQ(",,,\n20200217,1,0,20200218\n", Annotate("\n20200217\n"));
+    EXPECT_EQ("2020-02-17,is_holiday,is_trading_day,next_trading_day\n", Annotate("2020-02-17\n"));
+}
+
+TEST(CalendarAnnotator, InvalidRows)
+{
+    EXPECT_EQ("20200217,1,0,20200218\n"
+              "20201301,,,\n"
+              "2020021,,,\n"
+              ",,,\n"
+              "2020021x,,,\n"
+              "20200218,0,1,20200219\n",
+              Annotate("20200217\n20201301\n2020021\n\n2020021x\n20200218\n"));
+}
+
+TEST(CalendarAnnotator, DosLineEndingsAndNoFinalNewline)
+{
+    EXPECT_EQ("20200217\t1\t0\t20200218\r\n"
+              "20191231\t0\t1\t20200102",
+              Annotate("20200217\r\n20191231", '\t'));
+}
+
+TEST(CalendarAnnotator, OutsideCachedYears)
+{
+    EXPECT_EQ("20300101,1,0,20300102\n", Annotate("20300101\n"));
+}
+
+TEST(CalendarAnnotator, SmallBuffer)
+{
+    std::string input;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        input += "20200410,some longer trailing text\n";
+        expected += "20200410,some longer trailing text,1,0,20200413\n";
+    }
+    EXPECT_EQ(expected, Annotate(input, ',', 64));
+}
+
+TEST(CalendarAnnotator, RowLongerThanBuffer)
+{
+    EXPECT_EQ("failed", Annotate("20200410," + std::string(200, 'x') + "\n", ',', 64));
+    EXPECT_EQ("failed", Annotate("20200410," + std::string(56, 'x') + "\n", ',', 64));
+}
+
+TEST(CalendarAnnotator, RowFillingBuffer)
+{
+    // rows of exactly the buffer size, last without a newline
+    std::string row = "20200410," + std::string(55, 'x');
+    std::string annotated = row + ",1,0,20200413";
+    EXPECT_EQ(annotated, Annotate(row, ',', 64));
+    EXPECT_EQ(annotated + "\n" + annotated, Annotate(row + "\n" + row, ',', 64));
+    EXPECT_EQ(annotated + "\n" + annotated + "\n", Annotate(row + "\n" + row + "\n", ',', 64));
+}
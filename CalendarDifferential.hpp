@@ -0,0 +1,285 @@
+/// @file
+/// @brief Defines Holiday::CalendarDifferential which cross-checks every
+///        query path of the calendars against the reference holiday rules
+///        and an independent implementation of the Gregorian calendar.
+///        Shared by CalendarDifferential_test.cpp and the libFuzzer target
+///        in CalendarDifferential_fuzz.cpp.
+#pragma once
+
+#include "AdaptiveHolidayCalendar.hpp"
+#include "AsyncTradingDayCalendar.hpp"
+#include "Date.hpp"
+#include "HolidayC.h"
+#include "HolidayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketTradingDays_2000_2050.hpp"
+#include "USMarketHolidays.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief Compares cached, uncached, adaptive, static and asynchronously
+///        loaded calendars, weekend policies, the (y,m,d), yyyymmdd and Date
+///        overloads, trading day indices and counts, and the scalar and batch C
+///        interface against USMarketHolidays::IsMarketHoliday and
+///        reference date rules.
+///        Every check returns an empty string on agreement or a
+///        description of the first disagreement found.
+class CalendarDifferential
+{
+public:
+    /// @brief Years cached by the calendars under test.  Dates on either
+    ///        side of the range exercise the uncached fallback.
+    static const int StartYear = 1990;
+    static const int EndYear = 2050;
+    inline CalendarDifferential();
+    inline ~CalendarDifferential();
+    /// @brief Checks a year, month and day which need not be valid
+    inline std::string Check(int year, int month, int day) const;
+    /// @brief Checks a yyyymmdd value which need not be a valid date
+    inline std::string Check(int yyyymmdd) const;
+    /// @brief Checks that batch queries agree with scalar queries
+    inline std::string CheckBatch(const std::vector<std::int32_t>& dates) const;
+private:
+    CalendarDifferential(const CalendarDifferential&);
+    CalendarDifferential& operator=(const CalendarDifferential&);
+    static inline bool ReferenceValid(int year, int month, int day);
+    static inline DayOfWeek_t ReferenceDayOfWeek(int year, int month, int day);
+    inline std::string CheckDate(const Date& date, int year, int month, int day) const;
+    inline std::string CheckQueries(const Date& date) const;
+    inline std::string CheckIntQueries(int yyyymmdd) const;
+    HolidayCalendar<USMarketHolidays> m_Holidays;
+    HolidayCalendar<USMarketHolidays, SortedHolidayStorage> m_SortedHolidays;
+    HolidayCalendar<USMarketHolidays> m_UncachedHolidays;
+    // queries resize its cache, which is the behaviour being checked
+    mutable AdaptiveHolidayCalendar<USMarketHolidays> m_AdaptiveHolidays;
+    TradingDayCalendar<USMarketHolidays> m_TradingDays;
+    TradingDayCalendar<USMarketHolidays> m_UncachedTradingDays;
+    // checked while its background loading is still in progress
+    AsyncTradingDayCalendar<USMarketHolidays> m_AsyncTradingDays;
+    TradingDayCalendar<USMarketHolidays, FridaySaturdayWeekend> m_FridaySaturdayTradingDays;
+    TradingDayCalendar<USMarketHolidays, FridaySaturdayWeekend> m_UncachedFridaySaturdayTradingDays;
+    typedef StaticTradingDayCalendar<USMarketHolidays, 2000, 2050> StaticTradingDays_t;
+    holiday_calendar* m_Handle;
+};
+
+/// @brief Formats a mismatch between a fast path and the reference
+#define HOLIDAY_DIFFERENTIAL_EXPECT(what, expected, actual)              \
+    if ((expected) != (actual))                                          \
+    {                                                                    \
+        std::ostringstream message;                                      \
+        message << what << ": expected " << (expected)                   \
+                << " got " << (actual);                                  \
+        return message.str();                                            \
+    }
+
+CalendarDifferential::CalendarDifferential()
+    : m_Holidays(StartYear, EndYear)
+    , m_SortedHolidays(StartYear, EndYear)
+    , m_AdaptiveHolidays(1024, 64, 4)
+    , m_TradingDays(StartYear, EndYear)
+    , m_AsyncTradingDays(StartYear, EndYear, 2015, 2025)
+    , m_FridaySaturdayTradingDays(StartYear, EndYear)
+    , m_Handle(holiday_calendar_create(StartYear, EndYear))
+{
+}
+CalendarDifferential::~CalendarDifferential()
+{
+    holiday_calendar_destroy(m_Handle);
+}
+bool CalendarDifferential::ReferenceValid(int year, int month, int day)
+{
+    if (month < 1 || month > 12 || day < 1) return false;
+    if (month == 2)
+    {
+        bool leap = year % 400 == 0 || (year % 4 == 0 && year % 100 != 0);
+        return day <= (leap ? 29 : 28);
+    }
+    bool shortMonth = month == 4 || month == 6 || month == 9 || month == 11;
+    return day <= (shortMonth ? 30 : 31);
+}
+DayOfWeek_t CalendarDifferential::ReferenceDayOfWeek(int year, int month, int day)
+{
+    // Zeller's congruence shifted to Sunday == 0, with the year moved
+    // into a positive 400 year cycle so the divisions round down
+    if (month < 3)
+    {
+        month += 12;
+        year -= 1;
+    }
+    year = year % 400 + 400;
+    int k = year % 100;
+    int j = year / 100;
+    int h = (day + 13 * (month + 1) / 5 + k + k / 4 + j / 4 + 5 * j) % 7;
+    return (h + 6) % 7;
+}
+std::string CalendarDifferential::Check(int year, int month, int day) const
+{
+    std::ostringstream context;
+    context << "Date(" << year << "," << month << "," << day << ") ";
+    std::string failure = CheckDate(Date(year, month, day), year, month, day);
+    return failure.empty() ? failure : context.str() + failure;
+}
+std::string CalendarDifferential::Check(int yyyymmdd) const
+{
+    std::ostringstream context;
+    context << "Date(" << yyyymmdd << ") ";
+    std::string failure = yyyymmdd >= 0
+        ? CheckDate(Date(yyyymmdd), yyyymmdd / 10000, yyyymmdd / 100 % 100, yyyymmdd % 100)
+        : CheckQueries(Date(yyyymmdd));
+    if (failure.empty()) failure = CheckIntQueries(yyyymmdd);
+    return failure.empty() ? failure : context.str() + failure;
+}
+std::string CalendarDifferential::CheckIntQueries(int yyyymmdd) const
+{
+    Date date(yyyymmdd);
+    bool holiday = m_Holidays.IsMarketHoliday(date);
+    bool tradingDay = m_TradingDays.IsTradingDay(date);
+    HOLIDAY_DIFFERENTIAL_EXPECT("Valid of negative yyyymmdd", false, yyyymmdd < 0 && date.Valid());
+    HOLIDAY_DIFFERENTIAL_EXPECT("int IsMarketHoliday", holiday, m_Holidays.IsMarketHoliday(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int sorted IsMarketHoliday", holiday, m_SortedHolidays.IsMarketHoliday(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int uncached IsMarketHoliday", holiday, m_UncachedHolidays.IsMarketHoliday(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int adaptive IsMarketHoliday", holiday, m_AdaptiveHolidays.IsMarketHoliday(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int IsTradingDay", tradingDay, m_TradingDays.IsTradingDay(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int uncached IsTradingDay", tradingDay, m_UncachedTradingDays.IsTradingDay(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int async IsTradingDay", tradingDay, m_AsyncTradingDays.IsTradingDay(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("int static IsTradingDay", tradingDay, StaticTradingDays_t::IsTradingDay(yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("holiday_is_market_holiday", holiday ? 1 : 0, holiday_is_market_holiday(m_Handle, yyyymmdd));
+    HOLIDAY_DIFFERENTIAL_EXPECT("holiday_is_trading_day", tradingDay ? 1 : 0, holiday_is_trading_day(m_Handle, yyyymmdd));
+    return std::string();
+}
+std::string CalendarDifferential::CheckDate(const Date& date, int year, int month, int day) const
+{
+    bool valid = ReferenceValid(year, month, day);
+    HOLIDAY_DIFFERENTIAL_EXPECT("Valid", valid, date.Valid());
+    HOLIDAY_DIFFERENTIAL_EXPECT("Date(y,m,d) == Date", true, Date(year, month, day) == date);
+    if (valid)
+    {
+        HOLIDAY_DIFFERENTIAL_EXPECT("Year", year, date.Year());
+        HOLIDAY_DIFFERENTIAL_EXPECT("Month", month, date.Month());
+        HOLIDAY_DIFFERENTIAL_EXPECT("Day", day, date.Day());
+        HOLIDAY_DIFFERENTIAL_EXPECT("GetDayOfWeek", ReferenceDayOfWeek(year, month, day), date.GetDayOfWeek());
+        int days = date.DaysSinceEpoch();
+        HOLIDAY_DIFFERENTIAL_EXPECT("FromDaysSinceEpoch", true, Date::FromDaysSinceEpoch(days) == date);
+        HOLIDAY_DIFFERENTIAL_EXPECT("GetNextDay", true, Date::FromDaysSinceEpoch(days + 1) == date.GetNextDay());
+        HOLIDAY_DIFFERENTIAL_EXPECT("DayOfYear", days - Date(year, 1, 1).DaysSinceEpoch() + 1, date.DayOfYear());
+        HOLIDAY_DIFFERENTIAL_EXPECT("Quarter", (month - 1) / 3 + 1, date.Quarter());
+        HOLIDAY_DIFFERENTIAL_EXPECT("IsLeapYear", ReferenceValid(year, 2, 29), date.IsLeapYear());
+        // the ISO week is numbered within the year of its Thursday
+        int isoDayOfWeek = (ReferenceDayOfWeek(year, month, day) + 6) % 7;
+        Date thursday = Date::FromDaysSinceEpoch(days - isoDayOfWeek + 3);
+        HOLIDAY_DIFFERENTIAL_EXPECT("IsoWeekYear", thursday.Year(), date.IsoWeekYear());
+        HOLIDAY_DIFFERENTIAL_EXPECT("IsoWeek", (thursday.DayOfYear() - 1) / 7 + 1, date.IsoWeek());
+        if (year >= 0 && year <= 214747)
+        {
+            HOLIDAY_DIFFERENTIAL_EXPECT("operator int", year * 10000 + month * 100 + day, static_cast<int>(date));
+        }
+    }
+    else
+    {
+        HOLIDAY_DIFFERENTIAL_EXPECT("operator int", -1, static_cast<int>(date));
+        HOLIDAY_DIFFERENTIAL_EXPECT("GetDayOfWeek", DayOfWeek::NotApplicable, date.GetDayOfWeek());
+        HOLIDAY_DIFFERENTIAL_EXPECT("GetNextDay valid", false, date.GetNextDay().Valid());
+        HOLIDAY_DIFFERENTIAL_EXPECT("DayOfYear", 0, date.DayOfYear());
+        HOLIDAY_DIFFERENTIAL_EXPECT("IsoWeek", 0, date.IsoWeek());
+        HOLIDAY_DIFFERENTIAL_EXPECT("Quarter", 0, date.Quarter());
+    }
+    return CheckQueries(date);
+}
+std::string CalendarDifferential::CheckQueries(const Date& date) const
+{
+    bool holiday = date.Valid() && USMarketHolidays::IsMarketHoliday(date);
+    HOLIDAY_DIFFERENTIAL_EXPECT("USMarketHolidays on invalid date", holiday, USMarketHolidays::IsMarketHoliday(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("IsMarketHoliday", holiday, m_Holidays.IsMarketHoliday(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("sorted IsMarketHoliday", holiday, m_SortedHolidays.IsMarketHoliday(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("uncached IsMarketHoliday", holiday, m_UncachedHolidays.IsMarketHoliday(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("adaptive IsMarketHoliday", holiday, m_AdaptiveHolidays.IsMarketHoliday(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("(y,m,d) IsMarketHoliday", holiday,
+                                m_Holidays.IsMarketHoliday(date.Year(), date.Month(), date.Day()));
+    HOLIDAY_DIFFERENTIAL_EXPECT("(y,m,d) sorted IsMarketHoliday", holiday,
+                                m_SortedHolidays.IsMarketHoliday(date.Year(), date.Month(), date.Day()));
+
+    bool tradingDay = date.Valid() && !holiday && !date.IsWeekend();
+    HOLIDAY_DIFFERENTIAL_EXPECT("IsTradingDay", tradingDay, m_TradingDays.IsTradingDay(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("uncached IsTradingDay", tradingDay, m_UncachedTradingDays.IsTradingDay(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("async IsTradingDay", tradingDay, m_AsyncTradingDays.IsTradingDay(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("static IsTradingDay", tradingDay, StaticTradingDays_t::IsTradingDay(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("(y,m,d) IsTradingDay", tradingDay,
+                                m_TradingDays.IsTradingDay(date.Year(), date.Month(), date.Day()));
+
+    DayOfWeek_t dayofweek = date.GetDayOfWeek();
+    bool fridaySaturdayTradingDay = date.Valid() && !holiday
+        && dayofweek != DayOfWeek::Friday && dayofweek != DayOfWeek::Saturday;
+    HOLIDAY_DIFFERENTIAL_EXPECT("Friday/Saturday IsTradingDay", fridaySaturdayTradingDay,
+                                m_FridaySaturdayTradingDays.IsTradingDay(date));
+    HOLIDAY_DIFFERENTIAL_EXPECT("uncached Friday/Saturday IsTradingDay", fridaySaturdayTradingDay,
+                                m_UncachedFridaySaturdayTradingDays.IsTradingDay(date));
+
+    bool cached = date.Valid() && date.Year() >= StartYear && date.Year() <= EndYear;
+    int index = m_TradingDays.ToTradingDayIndex(date);
+    HOLIDAY_DIFFERENTIAL_EXPECT("ToTradingDayIndex found", cached && tradingDay, index >= 0);
+    int staticIndex = StaticTradingDays_t::ToTradingDayIndex(date);
+    HOLIDAY_DIFFERENTIAL_EXPECT("static ToTradingDayIndex found",
+                                tradingDay && date.Year() >= 2000 && date.Year() <= 2050, staticIndex >= 0);
+    if (staticIndex >= 0)
+    {
+        HOLIDAY_DIFFERENTIAL_EXPECT("static FromTradingDayIndex", true,
+                                    StaticTradingDays_t::FromTradingDayIndex(staticIndex) == date);
+    }
+    if (index >= 0)
+    {
+        HOLIDAY_DIFFERENTIAL_EXPECT("FromTradingDayIndex", true, m_TradingDays.FromTradingDayIndex(index) == date);
+        Date next = m_TradingDays.FromTradingDayIndex(index + 1);
+        if (next.Valid())
+        {
+            HOLIDAY_DIFFERENTIAL_EXPECT("FromTradingDayIndex of next index", true,
+                                        m_UncachedTradingDays.GetNextTradingDay(date) == next);
+        }
+    }
+
+    if (date.Valid() && date.Year() > -100000 && date.Year() < 100000)
+    {
+        Date week = Date::FromDaysSinceEpoch(date.DaysSinceEpoch() + 7);
+        HOLIDAY_DIFFERENTIAL_EXPECT("CountTradingDays", m_UncachedTradingDays.CountTradingDays(date, week),
+                                    m_TradingDays.CountTradingDays(date, week));
+        HOLIDAY_DIFFERENTIAL_EXPECT("static CountTradingDays", m_UncachedTradingDays.CountTradingDays(date, week),
+                                    StaticTradingDays_t::CountTradingDays(date, week));
+        Date next = m_UncachedTradingDays.GetNextTradingDay(date);
+        HOLIDAY_DIFFERENTIAL_EXPECT("GetNextTradingDay", true, m_TradingDays.GetNextTradingDay(date) == next);
+        HOLIDAY_DIFFERENTIAL_EXPECT("GetNextTradingDay is a trading day", true, m_UncachedTradingDays.IsTradingDay(next));
+        for (Date skipped = date.GetNextDay(); !(skipped == next); skipped = skipped.GetNextDay())
+        {
+            HOLIDAY_DIFFERENTIAL_EXPECT("GetNextTradingDay skipped a trading day", false,
+                                        m_UncachedTradingDays.IsTradingDay(skipped));
+        }
+    }
+    return std::string();
+}
+std::string CalendarDifferential::CheckBatch(const std::vector<std::int32_t>& dates) const
+{
+    std::vector<std::uint8_t> holidays(dates.size());
+    std::vector<std::uint8_t> tradingDays(dates.size());
+    HOLIDAY_DIFFERENTIAL_EXPECT("holiday_is_market_holiday_batch", 0,
+                                holiday_is_market_holiday_batch(m_Handle, dates.data(), dates.size(), holidays.data()));
+    HOLIDAY_DIFFERENTIAL_EXPECT("holiday_is_trading_day_batch", 0,
+                                holiday_is_trading_day_batch(m_Handle, dates.data(), dates.size(), tradingDays.data()));
+    for (std::size_t i = 0; i < dates.size(); ++i)
+    {
+        std::ostringstream context;
+        context << "Date(" << dates[i] << ") batch ";
+        HOLIDAY_DIFFERENTIAL_EXPECT(context.str() + "holiday_is_market_holiday_batch",
+                                    holiday_is_market_holiday(m_Handle, dates[i]), static_cast<int>(holidays[i]));
+        HOLIDAY_DIFFERENTIAL_EXPECT(context.str() + "holiday_is_trading_day_batch",
+                                    holiday_is_trading_day(m_Handle, dates[i]), static_cast<int>(tradingDays[i]));
+    }
+    return std::string();
+}
+
+#undef HOLIDAY_DIFFERENTIAL_EXPECT
+
+} // namespace Holiday
@@ -0,0 +1,43 @@
+/// @file
+/// @brief libFuzzer target differentially checking every calendar query
+///        path, see CalendarDifferential.hpp.  Built by configuring with
+///        clang and -DHOLIDAY_BUILD_FUZZER=ON, then run for example with
+///        ./CalendarDifferential_fuzz -max_total_time=600
+#include "CalendarDifferential.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Holiday;
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    static const CalendarDifferential differential;
+    std::vector<std::int32_t> dates;
+    for (; size >= 4; data += 4, size -= 4)
+    {
+        std::int32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        dates.push_back(value);
+
+        // also reinterpret the bytes as a year near the cached range
+        // (or anywhere within +/-100000 years) and a small month and day
+        int year = (data[0] & 1) ? (value >> 8) % 100000 : 1900 + (value >> 8) % 256;
+        int month = data[1] % 16 - 1;
+        int day = data[2] % 40 - 2;
+        std::string failure = differential.Check(year, month, day);
+        if (failure.empty()) failure = differential.Check(value);
+        if (!failure.empty())
+        {
+            std::fprintf(stderr, "%s\n", failure.c_str());
+            std::abort();
+        }
+    }
+    std::string failure = differential.CheckBatch(dates);
+    if (!failure.empty())
+    {
+        std::fprintf(stderr, "%s\n", failure.c_str());
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "CalendarDifferential.hpp"
+#include <random>
+
+using namespace Holiday;
+
+namespace
+{
+
+const CalendarDifferential& Differential()
+{
+    static const CalendarDifferential differential;
+    return differential;
+}
+
+} // namespace
+
+TEST(CalendarDifferential, EdgeCases)
+{
+    const int years[] = { -401, -1, 0, 1, 1582, 1599, 1600, 1700, 1899, 1900, 1969, 1970,
+                          1989, 1990, 1999, 2000, 2020, 2050, 2051, 2100, 2400, 9999, 10000 };
+    for (size_t y = 0; y < sizeof(years) / sizeof(years[0]); ++y)
+    {
+        for (int month = -1; month <= 14; ++month)
+        {
+            for (int day = -1; day <= 33; ++day)
+            {
+                EXPECT_EQ("", Differential().Check(years[y], month, day));
+                if (years[y] >= 0 && month >= 0 && day >= 0)
+                {
+                    EXPECT_EQ("", Differential().Check(years[y] * 10000 + month * 100 + day));
+                }
+            }
+        }
+    }
+    EXPECT_EQ("", Differential().Check(-1));
+    EXPECT_EQ("", Differential().Check(-20200101));
+    EXPECT_EQ("", Differential().Check(0));
+}
+
+TEST(CalendarDifferential, EveryDayAroundCache)
+{
+    std::vector<std::int32_t> dates;
+    for (Date date(1980,1,1); date.Year() <= 2060; date = date.GetNextDay())
+    {
+        dates.push_back(date);
+        ASSERT_EQ("", Differential().Check(date));
+    }
+    EXPECT_EQ("", Differential().CheckBatch(dates));
+}
+
+TEST(CalendarDifferential, Random)
+{
+    std::mt19937 generator(20200217);
+    std::uniform_int_distribution<int> anyInt(-2147483647 - 1, 2147483647);
+    std::uniform_int_distribution<int> year(-100000, 100000);
+    std::uniform_int_distribution<int> nearYear(1900, 2150);
+    std::uniform_int_distribution<int> month(0, 13);
+    std::uniform_int_distribution<int> day(0, 32);
+    std::vector<std::int32_t> dates;
+    for (int i = 0; i < 20000; ++i)
+    {
+        int y = (i % 2) ? year(generator) : nearYear(generator);
+        int m = month(generator);
+        int d = day(generator);
+        ASSERT_EQ("", Differential().Check(y, m, d));
+        if (y >= 0)
+        {
+            dates.push_back(y * 10000 + m * 100 + d);
+            ASSERT_EQ("", Differential().Check(dates.back()));
+        }
+        dates.push_back(anyInt(generator));
+        ASSERT_EQ("", Differential().Check(dates.back()));
+    }
+    EXPECT_EQ("", Differential().CheckBatch(dates));
+}
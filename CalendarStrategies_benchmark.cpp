@@ -0,0 +1,319 @@
+/// @file
+/// @brief Cross-validates every caching strategy of the calendars, from
+///        evaluating the rules on each query to the build-time tables, to
+///        pick defaults per deployment.  For each strategy and access
+///        pattern it measures the cold-start build time, the memory used,
+///        and the query latency with cold and hot CPU caches.
+///
+///        Usage: CalendarStrategies_benchmark [-q queries] [-t yyyymmdd] [-f csv|json] [output]
+///
+///        The patterns are a sequential scan of 2000 to 2050, uniformly
+///        random dates in those years, and dates clustered within weeks of
+///        today, which defaults to 2025-06-16 so runs are reproducible.
+///        The random dates use a fixed seed.  Writes one CSV row, or JSON
+///        object, per strategy and pattern to standard output when no file
+///        is given.
+///
+///        A cold query runs right after the calendar is built and the CPU
+///        caches are flushed; hot queries run after a warm-up pass.  The
+///        async calendar answers its cold queries while it is still loading
+///        and its hot queries once loading has finished.
+#include "AdaptiveHolidayCalendar.hpp"
+#include "AsyncTradingDayCalendar.hpp"
+#include "HolidayCalendar.hpp"
+#include "StaticTradingDayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include "USMarketTradingDays_2000_2050.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+const int StartYear = 2000;
+const int EndYear = 2050;
+/// builds timed per strategy and pattern, keeping the fastest
+const int BuildRuns = 3;
+/// cold measurements per strategy and pattern, each of ColdQueries queries
+const int ColdRuns = 16;
+const int ColdQueries = 256;
+/// timed passes over the dates once warm, keeping the fastest
+const int HotPasses = 3;
+/// larger than the last level cache of current servers
+const std::size_t FlushBytes = 64 << 20;
+
+typedef std::chrono::duration<double, std::nano> Nanoseconds_t;
+
+/// keeps the results of the cold queries from being optimized away
+volatile long g_Sink;
+
+struct Pattern
+{
+    const char* name;
+    std::vector<Date> dates;
+};
+
+struct Result
+{
+    std::string calendar;
+    std::string strategy;
+    std::string pattern;
+    double buildNs;
+    std::size_t memoryBytes;
+    double coldNs;
+    double hotNs;
+    long hits;
+};
+
+int Usage()
+{
+    std::fprintf(stderr, "usage: CalendarStrategies_benchmark [-q queries] [-t yyyymmdd] [-f csv|json] [output]\n");
+    return 2;
+}
+
+/// Evicts the calendar and the dates from the CPU caches
+void FlushCaches()
+{
+    static std::vector<char> buffer(FlushBytes);
+    static char value = 0;
+    ++value;
+    for (std::size_t i = 0; i < buffer.size(); i += 64) buffer[i] = value;
+}
+
+std::vector<Pattern> MakePatterns(std::size_t queries, const Date& today)
+{
+    int startDay = Date(StartYear,1,1).DaysSinceEpoch();
+    int endDay = Date(EndYear,12,31).DaysSinceEpoch();
+    std::mt19937 generator(42);
+    std::vector<Pattern> patterns(3);
+
+    patterns[0].name = "sequential";
+    for (std::size_t i = 0; i < queries; ++i)
+    {
+        patterns[0].dates.push_back(Date::FromDaysSinceEpoch(startDay + static_cast<int>(i % (endDay - startDay + 1))));
+    }
+    patterns[1].name = "random";
+    std::uniform_int_distribution<int> uniform(startDay, endDay);
+    for (std::size_t i = 0; i < queries; ++i)
+    {
+        patterns[1].dates.push_back(Date::FromDaysSinceEpoch(uniform(generator)));
+    }
+    patterns[2].name = "clustered";
+    std::normal_distribution<double> nearToday(today.DaysSinceEpoch(), 30);
+    for (std::size_t i = 0; i < queries; ++i)
+    {
+        int day = static_cast<int>(nearToday(generator));
+        patterns[2].dates.push_back(Date::FromDaysSinceEpoch(std::min(std::max(day, startDay), endDay)));
+    }
+    return patterns;
+}
+
+struct IsMarketHolidayQuery
+{
+    template <class Calendar>
+    bool operator()(Calendar& calendar, const Date& date) const { return calendar.IsMarketHoliday(date); }
+};
+
+struct IsTradingDayQuery
+{
+    template <class Calendar>
+    bool operator()(Calendar& calendar, const Date& date) const { return calendar.IsTradingDay(date); }
+};
+
+/// Waits for a calendar that loads in the background
+template <class Calendar>
+void Settle(Calendar&)
+{
+}
+template <class Holidays, class Weekend>
+void Settle(AsyncTradingDayCalendar<Holidays, Weekend>& calendar)
+{
+    calendar.Wait();
+}
+
+template <class Calendar, class Factory, class Query>
+void Measure(const char* calendarName, const char* strategy, Factory factory, Query query,
+             const std::vector<Pattern>& patterns, std::vector<Result>& results)
+{
+    for (std::size_t p = 0; p < patterns.size(); ++p)
+    {
+        const std::vector<Date>& dates = patterns[p].dates;
+        Result result = { calendarName, strategy, patterns[p].name, 0, 0, 0, 0, 0 };
+
+        std::unique_ptr<Calendar> calendar;
+        Nanoseconds_t cold(0);
+        long coldHits = 0;
+        for (int run = 0; run < ColdRuns; ++run)
+        {
+            if (run < BuildRuns)
+            {
+                calendar.reset();
+                FlushCaches();
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                calendar.reset(factory());
+                Nanoseconds_t build = std::chrono::steady_clock::now() - start;
+                if (run == 0 || build.count() < result.buildNs) result.buildNs = build.count();
+            }
+            FlushCaches();
+            std::size_t offset = (run * ColdQueries) % dates.size();
+            std::size_t count = std::min<std::size_t>(ColdQueries, dates.size() - offset);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (std::size_t i = offset; i < offset + count; ++i)
+            {
+                coldHits += query(*calendar, dates[i]) ? 1 : 0;
+            }
+            cold += std::chrono::steady_clock::now() - start;
+        }
+        result.coldNs = cold.count() / (ColdRuns * ColdQueries);
+        g_Sink = coldHits;
+
+        Settle(*calendar);
+        for (int pass = 0; pass <= HotPasses; ++pass)
+        {
+            long hits = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < dates.size(); ++i)
+            {
+                hits += query(*calendar, dates[i]) ? 1 : 0;
+            }
+            Nanoseconds_t hot = std::chrono::steady_clock::now() - start;
+            // the first pass only warms up
+            if (pass == 1 || (pass > 1 && hot.count() / dates.size() < result.hotNs))
+            {
+                result.hotNs = hot.count() / dates.size();
+            }
+            result.hits = hits;
+        }
+        result.memoryBytes = calendar->MemoryUsage();
+        results.push_back(result);
+        std::fprintf(stderr, "%-8s %-10s %-10s %12.0f %10zu %8.1f %8.1f\n", calendarName, strategy,
+                     patterns[p].name, result.buildNs, result.memoryBytes, result.coldNs, result.hotNs);
+    }
+}
+
+typedef HolidayCalendar<USMarketHolidays, HashHolidayStorage> HashCalendar_t;
+typedef HolidayCalendar<USMarketHolidays, SortedHolidayStorage> SortedCalendar_t;
+typedef AdaptiveHolidayCalendar<USMarketHolidays> AdaptiveCalendar_t;
+typedef TradingDayCalendar<USMarketHolidays> BitmapCalendar_t;
+typedef StaticTradingDayCalendar<USMarketHolidays, StartYear, EndYear> StaticCalendar_t;
+typedef AsyncTradingDayCalendar<USMarketHolidays> AsyncCalendar_t;
+
+HashCalendar_t* NewUncachedHolidays() { return new HashCalendar_t(); }
+HashCalendar_t* NewHashHolidays() { return new HashCalendar_t(StartYear, EndYear); }
+SortedCalendar_t* NewSortedHolidays() { return new SortedCalendar_t(StartYear, EndYear); }
+AdaptiveCalendar_t* NewAdaptiveHolidays() { return new AdaptiveCalendar_t(16 << 10); }
+BitmapCalendar_t* NewUncachedTradingDays() { return new BitmapCalendar_t(); }
+BitmapCalendar_t* NewBitmapTradingDays() { return new BitmapCalendar_t(StartYear, EndYear); }
+StaticCalendar_t* NewStaticTradingDays() { return new StaticCalendar_t(); }
+
+struct NewAsyncTradingDays
+{
+    int year;
+    AsyncCalendar_t* operator()() const { return new AsyncCalendar_t(StartYear, EndYear, year, year); }
+};
+
+void WriteCsv(std::FILE* file, const std::vector<Result>& results)
+{
+    std::fprintf(file, "calendar,strategy,pattern,build_ns,memory_bytes,cold_ns_per_query,hot_ns_per_query,hits\n");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        std::fprintf(file, "%s,%s,%s,%.0f,%zu,%.2f,%.2f,%ld\n", r.calendar.c_str(), r.strategy.c_str(),
+                     r.pattern.c_str(), r.buildNs, r.memoryBytes, r.coldNs, r.hotNs, r.hits);
+    }
+}
+
+void WriteJson(std::FILE* file, const std::vector<Result>& results, std::size_t queries, const Date& today)
+{
+    std::fprintf(file, "{\"queries\":%zu,\"today\":%d,\"startYear\":%d,\"endYear\":%d,\"results\":[",
+                 queries, static_cast<int>(today), StartYear, EndYear);
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        std::fprintf(file, "%s\n{\"calendar\":\"%s\",\"strategy\":\"%s\",\"pattern\":\"%s\","
+                     "\"buildNs\":%.0f,\"memoryBytes\":%zu,\"coldNsPerQuery\":%.2f,"
+                     "\"hotNsPerQuery\":%.2f,\"hits\":%ld}",
+                     i == 0 ? "" : ",", r.calendar.c_str(), r.strategy.c_str(), r.pattern.c_str(),
+                     r.buildNs, r.memoryBytes, r.coldNs, r.hotNs, r.hits);
+    }
+    std::fprintf(file, "\n]}\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t queries = 1000000;
+    Date today(2025,6,16);
+    bool json = false;
+    const char* file = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0')
+        {
+            if (i + 1 == argc) return Usage();
+            const char* value = argv[++i];
+            switch (argv[i - 1][1])
+            {
+                case 'q': queries = std::strtoul(value, NULL, 10); break;
+                case 't': today = Date(std::atoi(value)); break;
+                case 'f':
+                    if (std::strcmp(value, "json") == 0) json = true;
+                    else if (std::strcmp(value, "csv") != 0) return Usage();
+                    break;
+                default: return Usage();
+            }
+        }
+        else if (file == NULL)
+        {
+            file = argv[i];
+        }
+        else
+        {
+            return Usage();
+        }
+    }
+    if (queries < ColdQueries || !today.Valid() || today.Year() < StartYear || today.Year() > EndYear)
+    {
+        return Usage();
+    }
+
+    std::vector<Pattern> patterns = MakePatterns(queries, today);
+    std::vector<Result> results;
+    std::fprintf(stderr, "%-8s %-10s %-10s %12s %10s %8s %8s\n",
+                 "calendar", "strategy", "pattern", "build ns", "bytes", "cold ns", "hot ns");
+    Measure<HashCalendar_t>("holiday", "uncached", NewUncachedHolidays, IsMarketHolidayQuery(), patterns, results);
+    Measure<HashCalendar_t>("holiday", "hash", NewHashHolidays, IsMarketHolidayQuery(), patterns, results);
+    Measure<SortedCalendar_t>("holiday", "sorted", NewSortedHolidays, IsMarketHolidayQuery(), patterns, results);
+    Measure<AdaptiveCalendar_t>("holiday", "adaptive", NewAdaptiveHolidays, IsMarketHolidayQuery(), patterns, results);
+    Measure<BitmapCalendar_t>("trading", "uncached", NewUncachedTradingDays, IsTradingDayQuery(), patterns, results);
+    Measure<BitmapCalendar_t>("trading", "bitmap", NewBitmapTradingDays, IsTradingDayQuery(), patterns, results);
+    Measure<StaticCalendar_t>("trading", "static", NewStaticTradingDays, IsTradingDayQuery(), patterns, results);
+    NewAsyncTradingDays newAsync = { today.Year() };
+    Measure<AsyncCalendar_t>("trading", "async", newAsync, IsTradingDayQuery(), patterns, results);
+
+    std::FILE* output = file ? std::fopen(file, "w") : stdout;
+    if (output == NULL)
+    {
+        std::perror(file);
+        return 1;
+    }
+    if (json) WriteJson(output, results, queries, today);
+    else WriteCsv(output, results);
+    if (std::ferror(output) || (output != stdout && std::fclose(output) != 0))
+    {
+        std::fprintf(stderr, "CalendarStrategies_benchmark: failed to write results\n");
+        return 1;
+    }
+    return 0;
+}
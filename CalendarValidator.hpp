@@ -0,0 +1,184 @@
+/// @file
+/// @brief Defines Holiday::CalendarValidator which compares the holidays
+///        generated by a holiday policy against a reference list.
+#pragma once
+
+#include "Date.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief Dates of one year on which a holiday policy and a reference list
+///        disagree, as yyyymmdd values in ascending order
+struct YearDifferences
+{
+    int year;
+    /// in the reference list but not generated by the policy
+    std::vector<int> missing;
+    /// generated by the policy but not in the reference list
+    std::vector<int> extra;
+};
+
+/// @brief Validates the Holidays template parameter against reference
+///        lists of holidays.
+///
+///        The holidays generated for the range of years and the sorted
+///        reference list are merge-joined, so a validation takes time linear
+///        in the number of days and reference entries.
+template <class Holidays>
+class CalendarValidator
+{
+public:
+    /// @brief Generates the policy's holidays between the given years
+    CalendarValidator(int startYear, int endYear);
+    /// @brief Compares the generated holidays with a reference list of
+    ///        yyyymmdd values in any order.  Reference entries outside the
+    ///        range of years are ignored and invalid dates within it are
+    ///        reported missing.
+    /// @return the years with differences, in ascending order
+    std::vector<YearDifferences> Validate(std::vector<int> reference) const;
+    /// @brief Holidays generated by the policy, in ascending order
+    const std::vector<int>& Generated() const;
+    /// @brief Reads a reference list of yyyymmdd values from file, e.g. one
+    ///        date per line or a C array such as KnownUSMarketHolidays.hpp.
+    ///        Every 8 digit number not part of an identifier is read as a
+    ///        date.  Other numbers, C and C++ comments and lines beginning
+    ///        with '#' are skipped.
+    /// @return false on a read error
+    static bool ReadReference(std::FILE* file, std::vector<int>& reference);
+private:
+    static YearDifferences& ForYear(std::vector<YearDifferences>& differences, int yyyymmdd);
+    int m_StartYear;
+    int m_EndYear;
+    std::vector<int> m_Generated;
+};
+
+template <class Holidays>
+CalendarValidator<Holidays>::CalendarValidator(int startYear, int endYear)
+{
+    m_StartYear = startYear;
+    m_EndYear = endYear;
+    for (Date date(startYear,1,1); date.Year() <= endYear; date = date.GetNextDay())
+    {
+        if (Holidays::IsMarketHoliday(date))
+        {
+            m_Generated.push_back(date);
+        }
+    }
+}
+template <class Holidays>
+std::vector<YearDifferences> CalendarValidator<Holidays>::Validate(std::vector<int> reference) const
+{
+    std::sort(reference.begin(), reference.end());
+    reference.erase(std::unique(reference.begin(), reference.end()), reference.end());
+    std::vector<int>::const_iterator expected =
+        std::lower_bound(reference.cbegin(), reference.cend(), m_StartYear * 10000);
+    std::vector<int>::const_iterator expectedEnd =
+        std::lower_bound(expected, reference.cend(), (m_EndYear + 1) * 10000);
+    std::vector<int>::const_iterator generated = m_Generated.begin();
+
+    std::vector<YearDifferences> differences;
+    while (expected != expectedEnd || generated != m_Generated.end())
+    {
+        if (generated == m_Generated.end() || (expected != expectedEnd && *expected < *generated))
+        {
+            ForYear(differences, *expected).missing.push_back(*expected);
+            ++expected;
+        }
+        else if (expected == expectedEnd || *generated < *expected)
+        {
+            ForYear(differences, *generated).extra.push_back(*generated);
+            ++generated;
+        }
+        else
+        {
+            ++expected;
+            ++generated;
+        }
+    }
+    return differences;
+}
+template <class Holidays>
+const std::vector<int>& CalendarValidator<Holidays>::Generated() const
+{
+    return m_Generated;
+}
+template <class Holidays>
+YearDifferences& CalendarValidator<Holidays>::ForYear(std::vector<YearDifferences>& differences, int yyyymmdd)
+{
+    // dates are visited in ascending order so a new year is always last
+    int year = yyyymmdd / 10000;
+    if (differences.empty() || differences.back().year != year)
+    {
+        differences.push_back(YearDifferences());
+        differences.back().year = year;
+    }
+    return differences.back();
+}
+template <class Holidays>
+bool CalendarValidator<Holidays>::ReadReference(std::FILE* file, std::vector<int>& reference)
+{
+    bool lineStart = true;
+    bool lineComment = false;
+    bool blockComment = false;
+    bool identifier = false;
+    int digits = 0;
+    int value = 0;
+    for (int c = std::fgetc(file); ; c = std::fgetc(file))
+    {
+        bool digit = c != EOF && std::isdigit(c);
+        if (digits > 0 && !digit)
+        {
+            // sizes, years and other numbers are not dates
+            if (digits == 8) reference.push_back(value);
+            digits = 0;
+        }
+        if (c == EOF) break;
+        if (blockComment)
+        {
+            if (c == '*')
+            {
+                int next = std::fgetc(file);
+                if (next == '/') blockComment = false;
+                else std::ungetc(next, file);
+            }
+            continue;
+        }
+        if (c == '\n')
+        {
+            lineStart = true;
+            lineComment = false;
+            identifier = false;
+            continue;
+        }
+        if (lineStart && c == '#') lineComment = true;
+        lineStart = false;
+        if (lineComment) continue;
+        if (c == '/')
+        {
+            int next = std::fgetc(file);
+            if (next == '/') lineComment = true;
+            else if (next == '*') blockComment = true;
+            else std::ungetc(next, file);
+            identifier = false;
+            continue;
+        }
+        if (digit && !identifier)
+        {
+            if (digits == 0) value = 0;
+            if (digits < 8) value = value * 10 + (c - '0');
+            ++digits;
+        }
+        else
+        {
+            identifier = std::isalnum(c) || c == '_';
+        }
+    }
+    return !std::ferror(file);
+}
+
+} // namespace Holiday
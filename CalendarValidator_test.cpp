@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "CalendarValidator.hpp"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+/// Holidays on the first of January and the fourth of July
+class TwoHolidays
+{
+public:
+    static bool IsMarketHoliday(const Date& date)
+    {
+        return (date.Month() == 1 && date.Day() == 1) || (date.Month() == 7 && date.Day() == 4);
+    }
+};
+
+} // namespace
+
+TEST(CalendarValidator, Generated)
+{
+    CalendarValidator<TwoHolidays> validator(2019, 2020);
+    std::vector<int> expected = { 20190101, 20190704, 20200101, 20200704 };
+    EXPECT_EQ(expected, validator.Generated());
+}
+
+TEST(CalendarValidator, MatchingReference)
+{
+    CalendarValidator<TwoHolidays> validator(2019, 2020);
+    // unsorted, duplicated and outside the range of years
+    std::vector<int> reference = { 20200704, 20190101, 20210101, 20200101, 20190704, 20190704, 20181225 };
+    EXPECT_TRUE(validator.Validate(reference).empty());
+}
+
+TEST(CalendarValidator, MissingAndExtraPerYear)
+{
+    CalendarValidator<TwoHolidays> validator(2018, 2021);
+    std::vector<int> reference = { 20180101, 20180704,
+                                   20190101, 20191225, 20190704,
+                                   20200101, 20200704,
+                                   20210101, 20210230 };
+    std::vector<YearDifferences> differences = validator.Validate(reference);
+    ASSERT_EQ(2u, differences.size());
+    EXPECT_EQ(2019, differences[0].year);
+    EXPECT_EQ(std::vector<int>(1, 20191225), differences[0].missing);
+    EXPECT_TRUE(differences[0].extra.empty());
+    EXPECT_EQ(2021, differences[1].year);
+    EXPECT_EQ(std::vector<int>(1, 20210230), differences[1].missing);
+    EXPECT_EQ(std::vector<int>(1, 20210704), differences[1].extra);
+}
+
+TEST(CalendarValidator, ReadReference)
+{
+    const char text[] =
+        "#pragma once\n"
+        "const static int Known2Holidays[] = {\n"
+        "20190101,\n"
+        "20190704 20200101\n"
+        "};\n"
+        "20200704";
+    std::FILE* file = std::tmpfile();
+    ASSERT_TRUE(file != NULL);
+    std::fwrite(text, 1, std::strlen(text), file);
+    std::rewind(file);
+    std::vector<int> reference;
+    EXPECT_TRUE(CalendarValidator<TwoHolidays>::ReadReference(file, reference));
+    std::fclose(file);
+    std::vector<int> expected = { 20190101, 20190704, 20200101, 20200704 };
+    EXPECT_EQ(expected, reference);
+}
+
+TEST(CalendarValidator, ReadReferenceSkipsCommentsAndSizes)
+{
+    const char text[] =
+        "/* Known holidays, 2019 to 2020 */\n"
+        "static const int Known[3] = {20200101, // New Year 2020\n"
+        "20200217, /* 20200218 was not */ 20200410 // 20201225\n"
+        "};\n"
+        "static const int Count = 3;  /* 2020\n"
+        "   20200704 */ 123456789\n";
+    std::FILE* file = std::tmpfile();
+    ASSERT_TRUE(file != NULL);
+    std::fwrite(text, 1, std::strlen(text), file);
+    std::rewind(file);
+    std::vector<int> reference;
+    EXPECT_TRUE(CalendarValidator<TwoHolidays>::ReadReference(file, reference));
+    std::fclose(file);
+    std::vector<int> expected = { 20200101, 20200217, 20200410 };
+    EXPECT_EQ(expected, reference);
+}
@@ -4,7 +4,6 @@
 #pragma once
 
 #include <ctime>
-#include <cstring>
 
 namespace Holiday
 {
@@ -42,6 +41,10 @@ namespace Month
 
 /// @brief Helper class to extract useful date features
 ///        required when determining if a date is a holiday
+/// @note All calculations are done with integer arithmetic on the
+///       proleptic Gregorian calendar.  No libc time functions are used,
+///       so results do not depend on the process time zone and Date is
+///       safe to use from any number of threads without locking.
 class Date
 {
 public:
@@ -58,64 +61,98 @@ public:
     inline bool operator==(const Date& rhs) const;
     inline bool operator==(int rhs) const;
     inline DayOfWeek_t GetDayOfWeek() const;
+    /// @brief Day of the year, 1 for January 1st through 365 or 366.
+    ///        Returns 0 for an invalid date.
+    inline int DayOfYear() const;
+    /// @brief ISO 8601 week number, 1 through 52 or 53, of the week
+    ///        (starting Monday) containing the date.  Returns 0 for an
+    ///        invalid date.
+    inline int IsoWeek() const;
+    /// @brief Year the ISO 8601 week containing the date belongs to,
+    ///        which differs from Year() for a few days around January 1st.
+    ///        Returns 0 for an invalid date.
+    inline int IsoWeekYear() const;
+    /// @brief Calendar quarter, 1 through 4.  Returns 0 for an invalid date.
+    inline int Quarter() const;
+    /// @brief Returns true if the date is valid and in a leap year
+    inline bool IsLeapYear() const;
+    /// @brief Returns true if the provided year is a leap year
+    static inline bool IsLeapYear(int y);
     inline Date GetNextDay() const;
     inline bool IsWeekday() const;
     inline bool IsWeekend() const;
+    /// @brief Number of days since 1970-01-01, negative before it.
+    ///        Only meaningful for valid dates whose year is within
+    ///        five million years of 1970 so the count fits in an int.
+    inline int DaysSinceEpoch() const;
+    /// @brief Creates the date that is the given number of days
+    ///        since 1970-01-01
+    static inline Date FromDaysSinceEpoch(int days);
 private:
-    std::tm m_Date;
+    inline void Set(int y, int m, int d);
+    inline int IsoWeek(int& weekYear) const;
+    static inline int DaysInMonth(int y, int m);
+    static inline int IsoWeeksInYear(int y, DayOfWeek_t january1);
+    int m_Year;
+    int m_Month;
+    int m_Day;
     bool m_Valid;
 };
 
 Date::Date()
 {
-    memset(&m_Date, 0, sizeof(m_Date));
-    m_Valid = false;
+    Set(0, 0, 0);
 }
 Date::Date(const std::tm& date)
 {
-    m_Date = date;
-    std::mktime(&m_Date);
-    m_Valid = Matches(date);
+    Set(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday);
 }
 Date::Date(int y, int m, int d)
 {
-    memset(&m_Date, 0, sizeof(m_Date));
-    m_Date.tm_isdst = -1;
-    m_Date.tm_year = y - 1900;
-    m_Date.tm_mon = m - 1;
-    m_Date.tm_mday = d;
-    std::tm date = m_Date;
-    std::mktime(&m_Date);
-    m_Valid = Matches(date);
+    Set(y, m, d);
 }
 Date::Date(int yyyymmdd)
 {
-    memset(&m_Date, 0, sizeof(m_Date));
-    m_Date.tm_isdst = -1;
-    m_Date.tm_year = yyyymmdd / 10000 - 1900;
-    m_Date.tm_mon = yyyymmdd / 100 % 100 - 1;
-    m_Date.tm_mday = yyyymmdd % 100;
-    std::tm date = m_Date;
-    std::mktime(&m_Date);
-    m_Valid = Matches(date);
+    Set(yyyymmdd / 10000, yyyymmdd / 100 % 100, yyyymmdd % 100);
+}
+void Date::Set(int y, int m, int d)
+{
+    m_Year = y;
+    m_Month = m;
+    m_Day = d;
+    m_Valid = m >= Month::Janurary && m <= Month::December
+           && d >= 1 && d <= DaysInMonth(y, m);
+}
+bool Date::IsLeapYear(int y)
+{
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+bool Date::IsLeapYear() const
+{
+    return m_Valid && IsLeapYear(m_Year);
+}
+int Date::DaysInMonth(int y, int m)
+{
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (m == Month::Feburary && IsLeapYear(y)) ? 29 : days[m - 1];
 }
 bool Date::Matches(const std::tm& date) const
 {
-    return m_Date.tm_year == date.tm_year
-        && m_Date.tm_mon  == date.tm_mon
-        && m_Date.tm_mday == date.tm_mday;
+    return m_Year == date.tm_year + 1900
+        && m_Month == date.tm_mon + 1
+        && m_Day == date.tm_mday;
 }
 int Date::Year() const
 {
-    return m_Date.tm_year + 1900;
+    return m_Year;
 }
 int Date::Month() const
 {
-    return m_Date.tm_mon + 1;
+    return m_Month;
 }
 int Date::Day() const
 {
-    return m_Date.tm_mday;
+    return m_Day;
 }
 bool Date::Valid() const
 {
@@ -127,7 +164,10 @@ Date::operator int() const
 }
 bool Date::operator==(const Date& rhs) const
 {
-    return m_Valid == rhs.m_Valid && Matches(rhs.m_Date);
+    return m_Valid == rhs.m_Valid
+        && m_Year == rhs.m_Year
+        && m_Month == rhs.m_Month
+        && m_Day == rhs.m_Day;
 }
 bool Date::operator==(int rhs) const
 {
@@ -135,28 +175,106 @@ bool Date::operator==(int rhs) const
 }
 DayOfWeek_t Date::GetDayOfWeek() const
 {
-    return m_Valid ? m_Date.tm_wday : DayOfWeek::NotApplicable;
+    if (!m_Valid) return DayOfWeek::NotApplicable;
+    // 1970-01-01 was a Thursday
+    int dayofweek = (DaysSinceEpoch() + DayOfWeek::Thursday) % 7;
+    return dayofweek < 0 ? dayofweek + 7 : dayofweek;
+}
+int Date::DayOfYear() const
+{
+    static const int daysBeforeMonth[] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+    if (!m_Valid) return 0;
+    int leapDay = (m_Month > Month::Feburary && IsLeapYear(m_Year)) ? 1 : 0;
+    return daysBeforeMonth[m_Month - 1] + leapDay + m_Day;
+}
+int Date::IsoWeek() const
+{
+    int weekYear;
+    return IsoWeek(weekYear);
+}
+int Date::IsoWeekYear() const
+{
+    int weekYear;
+    IsoWeek(weekYear);
+    return weekYear;
+}
+int Date::IsoWeek(int& weekYear) const
+{
+    weekYear = 0;
+    if (!m_Valid) return 0;
+    // ISO weeks start on Monday and week 1 is the week with the year's
+    // first Thursday, so count from the Thursday of this date's week
+    DayOfWeek_t dayofweek = GetDayOfWeek();
+    int dayOfYear = DayOfYear();
+    int isoDayOfWeek = (dayofweek + 6) % 7 + 1;
+    int week = (dayOfYear - isoDayOfWeek + 10) / 7;
+    DayOfWeek_t january1 = ((dayofweek - (dayOfYear - 1)) % 7 + 7) % 7;
+    weekYear = m_Year;
+    if (week < 1)
+    {
+        weekYear = m_Year - 1;
+        int daysInPreviousYear = IsLeapYear(weekYear) ? 366 : 365;
+        return IsoWeeksInYear(weekYear, ((january1 - daysInPreviousYear) % 7 + 7) % 7);
+    }
+    if (week > IsoWeeksInYear(m_Year, january1))
+    {
+        weekYear = m_Year + 1;
+        return 1;
+    }
+    return week;
+}
+int Date::IsoWeeksInYear(int y, DayOfWeek_t january1)
+{
+    // years starting on a Thursday, or leap years starting on a
+    // Wednesday, have a 53rd week
+    return (january1 == DayOfWeek::Thursday
+        || (january1 == DayOfWeek::Wednesday && IsLeapYear(y))) ? 53 : 52;
+}
+int Date::Quarter() const
+{
+    static const int quarterOfMonth[] = { 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4 };
+    return m_Valid ? quarterOfMonth[m_Month] : 0;
 }
 Date Date::GetNextDay() const
 {
     if (!m_Valid) return Date();
-    std::tm date = m_Date;
-    time_t time = std::mktime(&date);
-    time += 24 * 60 * 60; // jump one day
-    localtime_r(&time, &date);
-    return Date(date);
+    if (m_Day < DaysInMonth(m_Year, m_Month)) return Date(m_Year, m_Month, m_Day + 1);
+    if (m_Month < Month::December) return Date(m_Year, m_Month + 1, 1);
+    return Date(m_Year + 1, Month::Janurary, 1);
 }
 bool Date::IsWeekday() const
 {
-    return GetDayOfWeek() == DayOfWeek::Monday
-        || GetDayOfWeek() == DayOfWeek::Tuesday
-        || GetDayOfWeek() == DayOfWeek::Wednesday
-        || GetDayOfWeek() == DayOfWeek::Thursday
-        || GetDayOfWeek() == DayOfWeek::Friday;
+    DayOfWeek_t dayofweek = GetDayOfWeek();
+    return dayofweek >= DayOfWeek::Monday
+        && dayofweek <= DayOfWeek::Friday;
 }
 bool Date::IsWeekend() const
 {
-    return GetDayOfWeek() == DayOfWeek::Saturday
-        || GetDayOfWeek() == DayOfWeek::Sunday;
+    DayOfWeek_t dayofweek = GetDayOfWeek();
+    return dayofweek == DayOfWeek::Saturday
+        || dayofweek == DayOfWeek::Sunday;
+}
+// The conversions to and from a day count use the era based algorithms
+// described in http://howardhinnant.github.io/date_algorithms.html
+int Date::DaysSinceEpoch() const
+{
+    int y = m_Year - (m_Month <= Month::Feburary ? 1 : 0);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yearOfEra = y - era * 400;
+    int dayOfYear = (153 * (m_Month + (m_Month > Month::Feburary ? -3 : 9)) + 2) / 5 + m_Day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+Date Date::FromDaysSinceEpoch(int days)
+{
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    int dayOfEra = days - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int mp = (5 * dayOfYear + 2) / 153;
+    int d = dayOfYear - (153 * mp + 2) / 5 + 1;
+    int m = mp < 10 ? mp + 3 : mp - 9;
+    return Date(yearOfEra + era * 400 + (m <= Month::Feburary ? 1 : 0), m, d);
 }
 } // namespace Holiday
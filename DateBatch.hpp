@@ -0,0 +1,45 @@
+/// @file
+/// @brief Defines Holiday::DateBatch which evaluates Date queries over
+///        arrays of yyyymmdd dates, e.g. to bucket rows by period.
+#pragma once
+
+#include "Date.hpp"
+#include <cstddef>
+
+namespace Holiday
+{
+
+/// @brief Batch forms of the Date queries.  Each function reads count
+///        yyyymmdd dates and writes count results, using the same value
+///        the scalar query returns for an invalid date.
+class DateBatch
+{
+public:
+    /// @brief Writes Date::DayOfYear of each date to results
+    static void DayOfYear(const int* dates, std::size_t count, int* results)
+    {
+        for (std::size_t i = 0; i < count; ++i) results[i] = Date(dates[i]).DayOfYear();
+    }
+    /// @brief Writes Date::IsoWeek of each date to results
+    static void IsoWeek(const int* dates, std::size_t count, int* results)
+    {
+        for (std::size_t i = 0; i < count; ++i) results[i] = Date(dates[i]).IsoWeek();
+    }
+    /// @brief Writes Date::IsoWeekYear of each date to results
+    static void IsoWeekYear(const int* dates, std::size_t count, int* results)
+    {
+        for (std::size_t i = 0; i < count; ++i) results[i] = Date(dates[i]).IsoWeekYear();
+    }
+    /// @brief Writes Date::Quarter of each date to results
+    static void Quarter(const int* dates, std::size_t count, int* results)
+    {
+        for (std::size_t i = 0; i < count; ++i) results[i] = Date(dates[i]).Quarter();
+    }
+    /// @brief Writes Date::IsLeapYear of each date to results
+    static void IsLeapYear(const int* dates, std::size_t count, bool* results)
+    {
+        for (std::size_t i = 0; i < count; ++i) results[i] = Date(dates[i]).IsLeapYear();
+    }
+};
+
+} // namespace Holiday
@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+#include "DateBatch.hpp"
+#include <vector>
+
+using namespace Holiday;
+
+TEST(DateBatch, MatchesScalar)
+{
+    std::vector<int> dates;
+    for (Date date(19991220); date.Year() <= 2030; date = date.GetNextDay())
+    {
+        dates.push_back(date);
+    }
+    dates.push_back(20201301);
+    dates.push_back(-1);
+    size_t count = dates.size();
+    std::vector<int> dayOfYear(count), isoWeek(count), isoWeekYear(count), quarter(count);
+    bool* leap = new bool[count];
+    DateBatch::DayOfYear(dates.data(), count, dayOfYear.data());
+    DateBatch::IsoWeek(dates.data(), count, isoWeek.data());
+    DateBatch::IsoWeekYear(dates.data(), count, isoWeekYear.data());
+    DateBatch::Quarter(dates.data(), count, quarter.data());
+    DateBatch::IsLeapYear(dates.data(), count, leap);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Date date(dates[i]);
+        EXPECT_EQ(date.DayOfYear(), dayOfYear[i]) << dates[i];
+        EXPECT_EQ(date.IsoWeek(), isoWeek[i]) << dates[i];
+        EXPECT_EQ(date.IsoWeekYear(), isoWeekYear[i]) << dates[i];
+        EXPECT_EQ(date.Quarter(), quarter[i]) << dates[i];
+        EXPECT_EQ(date.IsLeapYear(), leap[i]) << dates[i];
+    }
+    delete[] leap;
+}
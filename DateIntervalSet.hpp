@@ -0,0 +1,279 @@
+/// @file
+/// @brief Defines Holiday::DateIntervalSet, a set of dates stored as
+///        sorted runs of consecutive days, e.g. event windows or blackout
+///        periods.
+#pragma once
+
+#include "Date.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief Set of dates held as sorted, disjoint and non-adjacent intervals
+///        of consecutive calendar days.
+///
+///        Union, intersection and difference merge the two interval lists,
+///        and ExpandByTradingDays maps interval ends through a trading day
+///        calendar's index, so every operation takes time linear in the
+///        number of intervals however many days they cover.
+class DateIntervalSet
+{
+public:
+    inline DateIntervalSet();
+    /// @brief Adds the dates from first to last inclusive.  Ignored if
+    ///        either date is invalid or last is before first.
+    inline void Insert(const Date& first, const Date& last);
+    /// @brief Adds a single date
+    inline void Insert(const Date& date);
+    /// @brief Returns true if the date is in the set
+    inline bool Contains(const Date& date) const;
+    /// @brief Returns true if the set has no dates
+    inline bool Empty() const;
+    /// @brief Number of intervals of consecutive days
+    inline std::size_t IntervalCount() const;
+    /// @brief First date of the interval
+    inline Date First(std::size_t interval) const;
+    /// @brief Last date of the interval
+    inline Date Last(std::size_t interval) const;
+    /// @brief Number of dates in the set
+    inline int DayCount() const;
+    /// @brief Number of trading days of the calendar in the set
+    template <class TradingDays>
+    int TradingDayCount(const TradingDays& calendar) const;
+    /// @brief Dates in either set
+    inline DateIntervalSet Union(const DateIntervalSet& other) const;
+    /// @brief Dates in both sets
+    inline DateIntervalSet Intersection(const DateIntervalSet& other) const;
+    /// @brief Dates in this set but not the other
+    inline DateIntervalSet Difference(const DateIntervalSet& other) const;
+    /// @brief Extends every interval to start at the before'th trading day
+    ///        before it and end at the after'th trading day after it, e.g.
+    ///        to turn event dates into windows of trading days.  Negative
+    ///        counts are treated as 0, which leaves that end unchanged.
+    ///
+    ///        The TradingDays template parameter is a calendar such as
+    ///        TradingDayCalendar or StaticTradingDayCalendar.  Interval ends
+    ///        between its first and last cached trading days are moved in
+    ///        constant time using its trading day index; others are moved
+    ///        a day at a time, so the calendar must have trading days.
+    template <class TradingDays>
+    DateIntervalSet ExpandByTradingDays(const TradingDays& calendar, int before, int after) const;
+    inline bool operator==(const DateIntervalSet& rhs) const;
+private:
+    /// days since epoch of the first and last dates, inclusive
+    struct Interval
+    {
+        int first;
+        int last;
+    };
+    inline void Append(int first, int last);
+    template <class TradingDays>
+    static int StepTradingDays(const TradingDays& calendar, int day, int count, int direction);
+    std::vector<Interval> m_Intervals;
+};
+
+DateIntervalSet::DateIntervalSet()
+{
+}
+void DateIntervalSet::Append(int first, int last)
+{
+    // intervals arrive sorted by first day, so only the last can merge
+    if (!m_Intervals.empty() && first <= m_Intervals.back().last + 1)
+    {
+        m_Intervals.back().last = std::max(m_Intervals.back().last, last);
+        return;
+    }
+    Interval interval = { first, last };
+    m_Intervals.push_back(interval);
+}
+void DateIntervalSet::Insert(const Date& first, const Date& last)
+{
+    if (!first.Valid() || !last.Valid()) return;
+    int firstDay = first.DaysSinceEpoch();
+    int lastDay = last.DaysSinceEpoch();
+    if (lastDay < firstDay) return;
+    if (m_Intervals.empty() || firstDay > m_Intervals.back().last)
+    {
+        Append(firstDay, lastDay);
+        return;
+    }
+    // merge with every interval overlapping or adjacent to the new one
+    std::size_t begin = 0;
+    while (begin < m_Intervals.size() && m_Intervals[begin].last + 1 < firstDay) ++begin;
+    std::size_t end = begin;
+    while (end < m_Intervals.size() && m_Intervals[end].first <= lastDay + 1)
+    {
+        firstDay = std::min(firstDay, m_Intervals[end].first);
+        lastDay = std::max(lastDay, m_Intervals[end].last);
+        ++end;
+    }
+    Interval interval = { firstDay, lastDay };
+    m_Intervals.erase(m_Intervals.begin() + begin, m_Intervals.begin() + end);
+    m_Intervals.insert(m_Intervals.begin() + begin, interval);
+}
+void DateIntervalSet::Insert(const Date& date)
+{
+    Insert(date, date);
+}
+bool DateIntervalSet::Contains(const Date& date) const
+{
+    if (!date.Valid()) return false;
+    int day = date.DaysSinceEpoch();
+    std::size_t low = 0;
+    std::size_t high = m_Intervals.size();
+    while (low < high)
+    {
+        std::size_t middle = (low + high) / 2;
+        if (m_Intervals[middle].last < day) low = middle + 1;
+        else high = middle;
+    }
+    return low < m_Intervals.size() && m_Intervals[low].first <= day;
+}
+bool DateIntervalSet::Empty() const
+{
+    return m_Intervals.empty();
+}
+std::size_t DateIntervalSet::IntervalCount() const
+{
+    return m_Intervals.size();
+}
+Date DateIntervalSet::First(std::size_t interval) const
+{
+    return Date::FromDaysSinceEpoch(m_Intervals[interval].first);
+}
+Date DateIntervalSet::Last(std::size_t interval) const
+{
+    return Date::FromDaysSinceEpoch(m_Intervals[interval].last);
+}
+int DateIntervalSet::DayCount() const
+{
+    int count = 0;
+    for (std::size_t i = 0; i < m_Intervals.size(); ++i)
+    {
+        count += m_Intervals[i].last - m_Intervals[i].first + 1;
+    }
+    return count;
+}
+template <class TradingDays>
+int DateIntervalSet::TradingDayCount(const TradingDays& calendar) const
+{
+    int count = 0;
+    for (std::size_t i = 0; i < m_Intervals.size(); ++i)
+    {
+        count += calendar.CountTradingDays(Date::FromDaysSinceEpoch(m_Intervals[i].first),
+                                           Date::FromDaysSinceEpoch(m_Intervals[i].last + 1));
+    }
+    return count;
+}
+DateIntervalSet DateIntervalSet::Union(const DateIntervalSet& other) const
+{
+    DateIntervalSet result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < m_Intervals.size() || j < other.m_Intervals.size())
+    {
+        const Interval& next = j == other.m_Intervals.size()
+            || (i < m_Intervals.size() && m_Intervals[i].first <= other.m_Intervals[j].first)
+            ? m_Intervals[i++] : other.m_Intervals[j++];
+        result.Append(next.first, next.last);
+    }
+    return result;
+}
+DateIntervalSet DateIntervalSet::Intersection(const DateIntervalSet& other) const
+{
+    DateIntervalSet result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < m_Intervals.size() && j < other.m_Intervals.size())
+    {
+        int first = std::max(m_Intervals[i].first, other.m_Intervals[j].first);
+        int last = std::min(m_Intervals[i].last, other.m_Intervals[j].last);
+        if (first <= last) result.Append(first, last);
+        if (m_Intervals[i].last < other.m_Intervals[j].last) ++i;
+        else ++j;
+    }
+    return result;
+}
+DateIntervalSet DateIntervalSet::Difference(const DateIntervalSet& other) const
+{
+    DateIntervalSet result;
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < m_Intervals.size(); ++i)
+    {
+        int first = m_Intervals[i].first;
+        int last = m_Intervals[i].last;
+        while (j < other.m_Intervals.size() && other.m_Intervals[j].last < first) ++j;
+        // cut out every interval of other overlapping this one
+        for (std::size_t k = j; k < other.m_Intervals.size() && other.m_Intervals[k].first <= last; ++k)
+        {
+            if (other.m_Intervals[k].first > first) result.Append(first, other.m_Intervals[k].first - 1);
+            first = std::max(first, other.m_Intervals[k].last + 1);
+        }
+        if (first <= last) result.Append(first, last);
+    }
+    return result;
+}
+template <class TradingDays>
+int DateIntervalSet::StepTradingDays(const TradingDays& calendar, int day, int count, int direction)
+{
+    for (; count > 0; --count)
+    {
+        do day += direction;
+        while (!calendar.IsTradingDay(Date::FromDaysSinceEpoch(day)));
+    }
+    return day;
+}
+template <class TradingDays>
+DateIntervalSet DateIntervalSet::ExpandByTradingDays(const TradingDays& calendar, int before, int after) const
+{
+    before = std::max(before, 0);
+    after = std::max(after, 0);
+    int tradingDays = calendar.TradingDayCount();
+    Date firstTradingDay = calendar.FromTradingDayIndex(0);
+    int firstIndexed = tradingDays > 0 ? firstTradingDay.DaysSinceEpoch() : 1;
+    int lastIndexed = tradingDays > 0 ? calendar.FromTradingDayIndex(tradingDays - 1).DaysSinceEpoch() : 0;
+
+    DateIntervalSet result;
+    for (std::size_t i = 0; i < m_Intervals.size(); ++i)
+    {
+        int first = m_Intervals[i].first;
+        int last = m_Intervals[i].last;
+        if (before > 0)
+        {
+            // the trading days before first have indices up to rank - 1
+            int rank = first >= firstIndexed && first <= lastIndexed
+                ? calendar.CountTradingDays(firstTradingDay, Date::FromDaysSinceEpoch(first))
+                : -1;
+            first = rank >= before
+                ? calendar.FromTradingDayIndex(rank - before).DaysSinceEpoch()
+                : StepTradingDays(calendar, first, before, -1);
+        }
+        if (after > 0)
+        {
+            // the trading days after last have indices from rank
+            int rank = last >= firstIndexed && last <= lastIndexed
+                ? calendar.CountTradingDays(firstTradingDay, Date::FromDaysSinceEpoch(last + 1))
+                : -1;
+            last = rank >= 0 && rank + after - 1 < tradingDays
+                ? calendar.FromTradingDayIndex(rank + after - 1).DaysSinceEpoch()
+                : StepTradingDays(calendar, last, after, 1);
+        }
+        result.Append(first, last);
+    }
+    return result;
+}
+bool DateIntervalSet::operator==(const DateIntervalSet& rhs) const
+{
+    if (m_Intervals.size() != rhs.m_Intervals.size()) return false;
+    for (std::size_t i = 0; i < m_Intervals.size(); ++i)
+    {
+        if (m_Intervals[i].first != rhs.m_Intervals[i].first
+            || m_Intervals[i].last != rhs.m_Intervals[i].last) return false;
+    }
+    return true;
+}
+
+} // namespace Holiday
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "DateIntervalSet.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+
+using namespace Holiday;
+
+TEST(DateIntervalSet, InsertMergesOverlappingAndAdjacent)
+{
+    DateIntervalSet set;
+    EXPECT_TRUE(set.Empty());
+    set.Insert(Date(20200110), Date(20200115));
+    set.Insert(Date(20200101), Date(20200103));
+    set.Insert(Date(20200120));
+    EXPECT_EQ(3u, set.IntervalCount());
+    set.Insert(Date(20200104), Date(20200109));
+    set.Insert(Date(20200131), Date(20200101));
+    set.Insert(Date(20200230), Date(20200301));
+    ASSERT_EQ(2u, set.IntervalCount());
+    EXPECT_EQ(20200101, set.First(0));
+    EXPECT_EQ(20200115, set.Last(0));
+    EXPECT_EQ(20200120, set.First(1));
+    EXPECT_EQ(16, set.DayCount());
+    set.Insert(Date(20191231), Date(20200125));
+    ASSERT_EQ(1u, set.IntervalCount());
+    EXPECT_EQ(20191231, set.First(0));
+    EXPECT_EQ(20200125, set.Last(0));
+}
+
+TEST(DateIntervalSet, Contains)
+{
+    DateIntervalSet set;
+    set.Insert(Date(20200101), Date(20200103));
+    set.Insert(Date(20200110), Date(20200110));
+    EXPECT_FALSE(set.Contains(Date(20191231)));
+    EXPECT_TRUE(set.Contains(Date(20200101)));
+    EXPECT_TRUE(set.Contains(Date(20200103)));
+    EXPECT_FALSE(set.Contains(Date(20200104)));
+    EXPECT_TRUE(set.Contains(Date(20200110)));
+    EXPECT_FALSE(set.Contains(Date(20200111)));
+    EXPECT_FALSE(set.Contains(Date(20200132)));
+}
+
+TEST(DateIntervalSet, Algebra)
+{
+    DateIntervalSet a;
+    a.Insert(Date(20200101), Date(20200110));
+    a.Insert(Date(20200120), Date(20200131));
+    DateIntervalSet b;
+    b.Insert(Date(20200105), Date(20200121));
+    b.Insert(Date(20200125), Date(20200125));
+    b.Insert(Date(20200201), Date(20200205));
+
+    DateIntervalSet expectedUnion;
+    expectedUnion.Insert(Date(20200101), Date(20200205));
+    EXPECT_TRUE(expectedUnion == a.Union(b));
+    EXPECT_TRUE(expectedUnion == b.Union(a));
+
+    DateIntervalSet expectedIntersection;
+    expectedIntersection.Insert(Date(20200105), Date(20200110));
+    expectedIntersection.Insert(Date(20200120), Date(20200121));
+    expectedIntersection.Insert(Date(20200125));
+    EXPECT_TRUE(expectedIntersection == a.Intersection(b));
+    EXPECT_TRUE(expectedIntersection == b.Intersection(a));
+
+    DateIntervalSet expectedDifference;
+    expectedDifference.Insert(Date(20200101), Date(20200104));
+    expectedDifference.Insert(Date(20200122), Date(20200124));
+    expectedDifference.Insert(Date(20200126), Date(20200131));
+    EXPECT_TRUE(expectedDifference == a.Difference(b));
+    EXPECT_TRUE(a.Difference(a).Empty());
+    EXPECT_TRUE(a == a.Difference(DateIntervalSet()));
+
+    // every date is in exactly one of the difference, intersection and other difference
+    for (Date date(2019,12,25); static_cast<int>(date) <= 20200210; date = date.GetNextDay())
+    {
+        int count = a.Difference(b).Contains(date) + a.Intersection(b).Contains(date) + b.Difference(a).Contains(date);
+        EXPECT_EQ(a.Union(b).Contains(date) ? 1 : 0, count) << int(date);
+    }
+}
+
+TEST(DateIntervalSet, ExpandByTradingDays)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2000, 2040);
+    DateIntervalSet earnings;
+    earnings.Insert(Date(20200102));
+    earnings.Insert(Date(20200121));
+    // three trading days before and one after, skipping New Year's Day and MLK day
+    DateIntervalSet windows = earnings.ExpandByTradingDays(calendar, 3, 1);
+    ASSERT_EQ(2u, windows.IntervalCount());
+    EXPECT_EQ(20191227, windows.First(0));
+    EXPECT_EQ(20200103, windows.Last(0));
+    EXPECT_EQ(20200115, windows.First(1));
+    EXPECT_EQ(20200122, windows.Last(1));
+    EXPECT_EQ(10, windows.TradingDayCount(calendar));
+    EXPECT_TRUE(earnings == earnings.ExpandByTradingDays(calendar, 0, -1));
+}
+
+TEST(DateIntervalSet, ExpandByTradingDaysAgreesWithUncached)
+{
+    TradingDayCalendar<USMarketHolidays> cached(2010, 2020);
+    TradingDayCalendar<USMarketHolidays> uncached;
+    DateIntervalSet set;
+    for (Date date(2009,12,20); date.Year() <= 2021; date = Date::FromDaysSinceEpoch(date.DaysSinceEpoch() + 23))
+    {
+        set.Insert(date, Date::FromDaysSinceEpoch(date.DaysSinceEpoch() + date.Day() % 5));
+    }
+    for (int before = 0; before <= 12; before += 4)
+    {
+        for (int after = 0; after <= 12; after += 3)
+        {
+            EXPECT_TRUE(set.ExpandByTradingDays(uncached, before, after)
+                        == set.ExpandByTradingDays(cached, before, after)) << before << " " << after;
+        }
+    }
+    EXPECT_EQ(set.TradingDayCount(uncached), set.TradingDayCount(cached));
+}
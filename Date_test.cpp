@@ -126,3 +126,101 @@ TEST(Date, IsWeekend)
     EXPECT_TRUE(Date(20200411).IsWeekend());
     EXPECT_TRUE(Date(20200412).IsWeekend());
 }
+TEST(Date, Constructor_tm)
+{
+    std::tm tm = {};
+    tm.tm_year = 2020 - 1900;
+    tm.tm_mon = 1;
+    tm.tm_mday = 29;
+    Date date(tm);
+    EXPECT_TRUE(date.Valid());
+    EXPECT_TRUE(date.Matches(tm));
+    EXPECT_EQ(date, 20200229);
+    tm.tm_year = 2021 - 1900;
+    EXPECT_FALSE(Date(tm).Valid());
+}
+TEST(Date, LeapYears)
+{
+    EXPECT_TRUE(Date(20000229).Valid());
+    EXPECT_TRUE(Date(20200229).Valid());
+    EXPECT_FALSE(Date(19000229).Valid());
+    EXPECT_FALSE(Date(20210229).Valid());
+}
+TEST(Date, GetNextDayMonthAndLeapBoundaries)
+{
+    EXPECT_EQ(20200229, Date(20200228).GetNextDay());
+    EXPECT_EQ(20200301, Date(20200229).GetNextDay());
+    EXPECT_EQ(20210301, Date(20210228).GetNextDay());
+    EXPECT_EQ(20200501, Date(20200430).GetNextDay());
+    EXPECT_FALSE(Date().GetNextDay().Valid());
+}
+TEST(Date, GetNextDayAcrossDaylightSaving)
+{
+    // US and EU daylight saving transitions must not skip or repeat days
+    EXPECT_EQ(20200309, Date(20200308).GetNextDay());
+    EXPECT_EQ(20201102, Date(20201101).GetNextDay());
+    EXPECT_EQ(20200330, Date(20200329).GetNextDay());
+    EXPECT_EQ(20201026, Date(20201025).GetNextDay());
+}
+TEST(Date, DaysSinceEpoch)
+{
+    EXPECT_EQ(0, Date(19700101).DaysSinceEpoch());
+    EXPECT_EQ(-1, Date(19691231).DaysSinceEpoch());
+    EXPECT_EQ(18312, Date(20200220).DaysSinceEpoch());
+    EXPECT_EQ(DayOfWeek::Thursday, Date(19700101).GetDayOfWeek());
+    EXPECT_EQ(DayOfWeek::Monday, Date(16000103).GetDayOfWeek());
+    EXPECT_EQ(DayOfWeek::Tuesday, Date(29991231).GetDayOfWeek());
+}
+TEST(Date, FromDaysSinceEpoch)
+{
+    EXPECT_EQ(19700101, Date::FromDaysSinceEpoch(0));
+    EXPECT_EQ(20200220, Date::FromDaysSinceEpoch(18312));
+    Date date(15000101);
+    for (int days = date.DaysSinceEpoch(); date.Year() < 2500; date = date.GetNextDay(), ++days)
+    {
+        ASSERT_EQ(days, date.DaysSinceEpoch()) << static_cast<int>(date);
+        ASSERT_EQ(date, Date::FromDaysSinceEpoch(days)) << days;
+    }
+}
+TEST(Date, DayOfYear)
+{
+    EXPECT_EQ(0, Date().DayOfYear());
+    EXPECT_EQ(1, Date(20200101).DayOfYear());
+    EXPECT_EQ(60, Date(20200229).DayOfYear());
+    EXPECT_EQ(61, Date(20200301).DayOfYear());
+    EXPECT_EQ(60, Date(20210301).DayOfYear());
+    EXPECT_EQ(366, Date(20201231).DayOfYear());
+    EXPECT_EQ(365, Date(20211231).DayOfYear());
+}
+TEST(Date, IsoWeek)
+{
+    EXPECT_EQ(0, Date().IsoWeek());
+    EXPECT_EQ(0, Date().IsoWeekYear());
+    const int dates[][3] = { { 20200101, 2020, 1 }, { 20210101, 2020, 53 },
+                             { 20191230, 2020, 1 }, { 20151231, 2015, 53 },
+                             { 20270101, 2026, 53 }, { 20081229, 2009, 1 },
+                             { 20100103, 2009, 53 }, { 20201231, 2020, 53 },
+                             { 20240101, 2024, 1 }, { 20200217, 2020, 8 } };
+    for (size_t i = 0; i < sizeof(dates) / sizeof(dates[0]); ++i)
+    {
+        EXPECT_EQ(dates[i][1], Date(dates[i][0]).IsoWeekYear()) << dates[i][0];
+        EXPECT_EQ(dates[i][2], Date(dates[i][0]).IsoWeek()) << dates[i][0];
+    }
+}
+TEST(Date, Quarter)
+{
+    EXPECT_EQ(0, Date().Quarter());
+    EXPECT_EQ(1, Date(20200101).Quarter());
+    EXPECT_EQ(1, Date(20200331).Quarter());
+    EXPECT_EQ(2, Date(20200401).Quarter());
+    EXPECT_EQ(3, Date(20200930).Quarter());
+    EXPECT_EQ(4, Date(20201231).Quarter());
+}
+TEST(Date, IsLeapYear)
+{
+    EXPECT_FALSE(Date().IsLeapYear());
+    EXPECT_TRUE(Date(20200101).IsLeapYear());
+    EXPECT_FALSE(Date(20210101).IsLeapYear());
+    EXPECT_TRUE(Date::IsLeapYear(2000));
+    EXPECT_FALSE(Date::IsLeapYear(1900));
+}
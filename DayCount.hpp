@@ -0,0 +1,120 @@
+/// @file
+/// @brief Defines day count conventions and Holiday::DayCount which
+///        computes accrual year fractions between two dates.
+#pragma once
+
+#include "Date.hpp"
+#include <cstddef>
+#include <limits>
+
+namespace Holiday
+{
+
+typedef int DayCountConvention_t;
+namespace DayCountConvention
+{
+    /// actual days / 360
+    static const DayCountConvention_t Actual360 = 0;
+    /// actual days / 365
+    static const DayCountConvention_t Actual365Fixed = 1;
+    /// 30/360 US bond basis (ISDA 30/360)
+    static const DayCountConvention_t Thirty360 = 2;
+    /// 30E/360 Eurobond basis
+    static const DayCountConvention_t ThirtyE360 = 3;
+    /// Actual/Actual ISDA, days in leap years / 366 plus other days / 365
+    static const DayCountConvention_t ActualActual = 4;
+    /// trading days / 252, counting the start date but not the end date
+    static const DayCountConvention_t Business252 = 5;
+}
+
+/// @brief Computes the year fraction between two dates under a day count
+///        convention.  Fractions are negative when the end date is before
+///        the start date, and NaN when either date is invalid.
+///
+///        The TradingDays template parameter is the calendar used by
+///        Business252, e.g. TradingDayCalendar<USMarketHolidays>, which
+///        answers in constant time between dates within its cached years.
+template <class TradingDays>
+class DayCount
+{
+public:
+    /// @brief Creates a day count for the convention using calendar, which
+    ///        must outlive the day count, for Business252
+    DayCount(DayCountConvention_t convention, const TradingDays& calendar);
+    /// @brief Year fraction from start to end
+    double YearFraction(const Date& start, const Date& end) const;
+    /// @brief Year fraction from the yyyymmdd start to the yyyymmdd end
+    double YearFraction(int start, int end) const;
+    /// @brief Writes the year fractions of count pairs of yyyymmdd start
+    ///        and end dates to results
+    void YearFraction(const int* starts, const int* ends, std::size_t count, double* results) const;
+
+    /// @brief Actual number of days from start to end
+    static int ActualDays(const Date& start, const Date& end);
+    /// @brief Days from start to end counting every month as 30 days,
+    ///        using the 30/360 US bond basis or the 30E/360 rules
+    static int Days360(const Date& start, const Date& end, bool european);
+    /// @brief Actual/Actual ISDA year fraction from start to end
+    static double ActualActual(const Date& start, const Date& end);
+private:
+    DayCountConvention_t m_Convention;
+    const TradingDays& m_Calendar;
+};
+
+template <class TradingDays>
+DayCount<TradingDays>::DayCount(DayCountConvention_t convention, const TradingDays& calendar)
+    : m_Convention(convention)
+    , m_Calendar(calendar)
+{
+}
+template <class TradingDays>
+double DayCount<TradingDays>::YearFraction(const Date& start, const Date& end) const
+{
+    if (!start.Valid() || !end.Valid()) return std::numeric_limits<double>::quiet_NaN();
+    switch (m_Convention)
+    {
+        case DayCountConvention::Actual360: return ActualDays(start, end) / 360.0;
+        case DayCountConvention::Actual365Fixed: return ActualDays(start, end) / 365.0;
+        case DayCountConvention::Thirty360: return Days360(start, end, false) / 360.0;
+        case DayCountConvention::ThirtyE360: return Days360(start, end, true) / 360.0;
+        case DayCountConvention::ActualActual: return ActualActual(start, end);
+        case DayCountConvention::Business252: return m_Calendar.CountTradingDays(start, end) / 252.0;
+        default: return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+template <class TradingDays>
+double DayCount<TradingDays>::YearFraction(int start, int end) const
+{
+    return YearFraction(Date(start), Date(end));
+}
+template <class TradingDays>
+void DayCount<TradingDays>::YearFraction(const int* starts, const int* ends, std::size_t count, double* results) const
+{
+    for (std::size_t i = 0; i < count; ++i) results[i] = YearFraction(Date(starts[i]), Date(ends[i]));
+}
+template <class TradingDays>
+int DayCount<TradingDays>::ActualDays(const Date& start, const Date& end)
+{
+    return end.DaysSinceEpoch() - start.DaysSinceEpoch();
+}
+template <class TradingDays>
+int DayCount<TradingDays>::Days360(const Date& start, const Date& end, bool european)
+{
+    int startDay = start.Day() == 31 ? 30 : start.Day();
+    int endDay = end.Day();
+    if (endDay == 31 && (european || startDay == 30)) endDay = 30;
+    return 360 * (end.Year() - start.Year()) + 30 * (end.Month() - start.Month()) + endDay - startDay;
+}
+template <class TradingDays>
+double DayCount<TradingDays>::ActualActual(const Date& start, const Date& end)
+{
+    if (end.DaysSinceEpoch() < start.DaysSinceEpoch()) return -ActualActual(end, start);
+    double startYearDays = start.IsLeapYear() ? 366.0 : 365.0;
+    if (start.Year() == end.Year()) return ActualDays(start, end) / startYearDays;
+    double endYearDays = end.IsLeapYear() ? 366.0 : 365.0;
+    return ActualDays(start, Date(start.Year() + 1, 1, 1)) / startYearDays
+         + (end.Year() - start.Year() - 1)
+         + ActualDays(Date(end.Year(), 1, 1), end) / endYearDays;
+}
+
+} // namespace Holiday
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "DayCount.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <cmath>
+
+using namespace Holiday;
+
+typedef DayCount<TradingDayCalendar<USMarketHolidays> > USDayCount;
+
+TEST(DayCount, Actual)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2020,2020);
+    USDayCount actual360(DayCountConvention::Actual360, calendar);
+    USDayCount actual365(DayCountConvention::Actual365Fixed, calendar);
+    EXPECT_DOUBLE_EQ(182 / 360.0, actual360.YearFraction(20200101, 20200701));
+    EXPECT_DOUBLE_EQ(182 / 365.0, actual365.YearFraction(20200101, 20200701));
+    EXPECT_DOUBLE_EQ(-182 / 365.0, actual365.YearFraction(20200701, 20200101));
+    EXPECT_DOUBLE_EQ(0.0, actual360.YearFraction(20200101, 20200101));
+}
+
+TEST(DayCount, Thirty360)
+{
+    TradingDayCalendar<USMarketHolidays> calendar;
+    USDayCount us(DayCountConvention::Thirty360, calendar);
+    USDayCount european(DayCountConvention::ThirtyE360, calendar);
+    EXPECT_DOUBLE_EQ(60 / 360.0, us.YearFraction(20200131, 20200331));
+    EXPECT_DOUBLE_EQ(60 / 360.0, european.YearFraction(20200131, 20200331));
+    EXPECT_DOUBLE_EQ(76 / 360.0, us.YearFraction(20200115, 20200331));
+    EXPECT_DOUBLE_EQ(75 / 360.0, european.YearFraction(20200115, 20200331));
+    EXPECT_DOUBLE_EQ(1.0, us.YearFraction(20190228, 20200228));
+}
+
+TEST(DayCount, ActualActual)
+{
+    TradingDayCalendar<USMarketHolidays> calendar;
+    USDayCount actualActual(DayCountConvention::ActualActual, calendar);
+    EXPECT_DOUBLE_EQ(61 / 365.0 + 60 / 366.0, actualActual.YearFraction(20191101, 20200301));
+    EXPECT_DOUBLE_EQ(-(61 / 365.0 + 60 / 366.0), actualActual.YearFraction(20200301, 20191101));
+    EXPECT_DOUBLE_EQ(1.0, actualActual.YearFraction(20200101, 20210101));
+    EXPECT_DOUBLE_EQ(3.0 + 31 / 365.0, actualActual.YearFraction(20190101, 20220201));
+}
+
+TEST(DayCount, Business252)
+{
+    TradingDayCalendar<USMarketHolidays> cached(2000,2040);
+    TradingDayCalendar<USMarketHolidays> uncached;
+    USDayCount business(DayCountConvention::Business252, cached);
+    // the 2nd, 3rd, 6th and 7th are trading days
+    EXPECT_DOUBLE_EQ(4 / 252.0, business.YearFraction(20200101, 20200108));
+    EXPECT_EQ(4, cached.CountTradingDays(Date(20200101), Date(20200108)));
+    EXPECT_EQ(-4, cached.CountTradingDays(Date(20200108), Date(20200101)));
+    EXPECT_EQ(cached.TradingDayCount(), cached.CountTradingDays(Date(20000101), Date(20410101)));
+    for (Date start(1999,12,1); start.Year() < 2041; start = Date::FromDaysSinceEpoch(start.DaysSinceEpoch() + 37))
+    {
+        Date end = Date::FromDaysSinceEpoch(start.DaysSinceEpoch() + 400);
+        EXPECT_EQ(uncached.CountTradingDays(start, end), cached.CountTradingDays(start, end)) << int(start);
+    }
+}
+
+TEST(DayCount, InvalidDates)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2020,2020);
+    USDayCount business(DayCountConvention::Business252, calendar);
+    USDayCount actual360(DayCountConvention::Actual360, calendar);
+    EXPECT_TRUE(std::isnan(business.YearFraction(20200101, 20201301)));
+    EXPECT_TRUE(std::isnan(actual360.YearFraction(20200230, 20200301)));
+    EXPECT_EQ(0, calendar.CountTradingDays(Date(20200101), Date(20201301)));
+}
+
+TEST(DayCount, Batch)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2020,2020);
+    USDayCount business(DayCountConvention::Business252, calendar);
+    const int starts[] = { 20200101, 20200108, 20200101 };
+    const int ends[] = { 20200108, 20200101, 20201301 };
+    double results[3];
+    business.YearFraction(starts, ends, 3, results);
+    EXPECT_DOUBLE_EQ(4 / 252.0, results[0]);
+    EXPECT_DOUBLE_EQ(-4 / 252.0, results[1]);
+    EXPECT_TRUE(std::isnan(results[2]));
+}
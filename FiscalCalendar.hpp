@@ -0,0 +1,84 @@
+/// @file
+/// @brief Defines Holiday::FiscalCalendar which maps dates to fiscal
+///        years, quarters and periods.
+#pragma once
+
+#include "Date.hpp"
+#include <cstddef>
+
+namespace Holiday
+{
+
+/// @brief Maps dates to fiscal years, quarters and monthly periods for a
+///        fiscal year that starts on the first day of a given month.
+///        The mapping is precomputed into per-month tables so each query
+///        is a couple of table lookups.
+class FiscalCalendar
+{
+public:
+    /// @brief Creates a fiscal calendar
+    /// @param startMonth first month of the fiscal year
+    /// @param namedByEndYear true if a fiscal year is named after the
+    ///        calendar year it ends in (US federal FY2021 starts in
+    ///        October 2020), false if named after the year it starts in
+    inline FiscalCalendar(Month_t startMonth = Month::Janurary, bool namedByEndYear = true);
+    /// @brief Fiscal year of the date, 0 for an invalid date
+    inline int FiscalYear(const Date& date) const;
+    /// @brief Fiscal quarter of the date, 1 through 4, 0 for an invalid date
+    inline int FiscalQuarter(const Date& date) const;
+    /// @brief Fiscal period (month of the fiscal year) of the date,
+    ///        1 through 12, 0 for an invalid date
+    inline int FiscalPeriod(const Date& date) const;
+    /// @brief Writes the fiscal year of each yyyymmdd date to results
+    inline void FiscalYear(const int* dates, std::size_t count, int* results) const;
+    /// @brief Writes the fiscal quarter of each yyyymmdd date to results
+    inline void FiscalQuarter(const int* dates, std::size_t count, int* results) const;
+    /// @brief Writes the fiscal period of each yyyymmdd date to results
+    inline void FiscalPeriod(const int* dates, std::size_t count, int* results) const;
+private:
+    // indexed by calendar month, entry 0 is used for invalid dates
+    int m_Period[13];
+    int m_YearOffset[13];
+};
+
+FiscalCalendar::FiscalCalendar(Month_t startMonth, bool namedByEndYear)
+{
+    m_Period[0] = 0;
+    m_YearOffset[0] = 0;
+    for (int month = Month::Janurary; month <= Month::December; ++month)
+    {
+        bool beforeStart = month < startMonth;
+        m_Period[month] = (month - startMonth + 12) % 12 + 1;
+        // months before the start belong to the fiscal year that began
+        // in the previous calendar year
+        int startYearOffset = beforeStart ? -1 : 0;
+        bool crossesYear = startMonth != Month::Janurary;
+        m_YearOffset[month] = startYearOffset + ((namedByEndYear && crossesYear) ? 1 : 0);
+    }
+}
+int FiscalCalendar::FiscalYear(const Date& date) const
+{
+    return date.Valid() ? date.Year() + m_YearOffset[date.Month()] : 0;
+}
+int FiscalCalendar::FiscalQuarter(const Date& date) const
+{
+    return date.Valid() ? (m_Period[date.Month()] + 2) / 3 : 0;
+}
+int FiscalCalendar::FiscalPeriod(const Date& date) const
+{
+    return date.Valid() ? m_Period[date.Month()] : 0;
+}
+void FiscalCalendar::FiscalYear(const int* dates, std::size_t count, int* results) const
+{
+    for (std::size_t i = 0; i < count; ++i) results[i] = FiscalYear(Date(dates[i]));
+}
+void FiscalCalendar::FiscalQuarter(const int* dates, std::size_t count, int* results) const
+{
+    for (std::size_t i = 0; i < count; ++i) results[i] = FiscalQuarter(Date(dates[i]));
+}
+void FiscalCalendar::FiscalPeriod(const int* dates, std::size_t count, int* results) const
+{
+    for (std::size_t i = 0; i < count; ++i) results[i] = FiscalPeriod(Date(dates[i]));
+}
+
+} // namespace Holiday
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "FiscalCalendar.hpp"
+
+using namespace Holiday;
+
+TEST(FiscalCalendar, CalendarYear)
+{
+    FiscalCalendar calendar;
+    EXPECT_EQ(2020, calendar.FiscalYear(Date(20200101)));
+    EXPECT_EQ(2020, calendar.FiscalYear(Date(20201231)));
+    EXPECT_EQ(1, calendar.FiscalQuarter(Date(20200331)));
+    EXPECT_EQ(4, calendar.FiscalQuarter(Date(20201001)));
+    EXPECT_EQ(2, calendar.FiscalPeriod(Date(20200229)));
+}
+
+TEST(FiscalCalendar, NamedByEndYear)
+{
+    // US federal government fiscal year
+    FiscalCalendar calendar(Month::October);
+    EXPECT_EQ(2020, calendar.FiscalYear(Date(20200930)));
+    EXPECT_EQ(2021, calendar.FiscalYear(Date(20201001)));
+    EXPECT_EQ(1, calendar.FiscalQuarter(Date(20201001)));
+    EXPECT_EQ(1, calendar.FiscalPeriod(Date(20201001)));
+    EXPECT_EQ(2, calendar.FiscalQuarter(Date(20210101)));
+    EXPECT_EQ(4, calendar.FiscalQuarter(Date(20200930)));
+    EXPECT_EQ(12, calendar.FiscalPeriod(Date(20200930)));
+}
+
+TEST(FiscalCalendar, NamedByStartYear)
+{
+    FiscalCalendar calendar(Month::April, false);
+    EXPECT_EQ(2019, calendar.FiscalYear(Date(20200331)));
+    EXPECT_EQ(2020, calendar.FiscalYear(Date(20200401)));
+    EXPECT_EQ(4, calendar.FiscalQuarter(Date(20200331)));
+    EXPECT_EQ(1, calendar.FiscalQuarter(Date(20200401)));
+    EXPECT_EQ(10, calendar.FiscalPeriod(Date(20210115)));
+}
+
+TEST(FiscalCalendar, InvalidDate)
+{
+    FiscalCalendar calendar(Month::July);
+    EXPECT_EQ(0, calendar.FiscalYear(Date(20201301)));
+    EXPECT_EQ(0, calendar.FiscalQuarter(Date(20201301)));
+    EXPECT_EQ(0, calendar.FiscalPeriod(Date()));
+}
+
+TEST(FiscalCalendar, Batch)
+{
+    FiscalCalendar calendar(Month::July);
+    const int dates[] = { 20200630, 20200701, 20201301, 20210101 };
+    int years[4], quarters[4], periods[4];
+    calendar.FiscalYear(dates, 4, years);
+    calendar.FiscalQuarter(dates, 4, quarters);
+    calendar.FiscalPeriod(dates, 4, periods);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(calendar.FiscalYear(Date(dates[i])), years[i]) << dates[i];
+        EXPECT_EQ(calendar.FiscalQuarter(Date(dates[i])), quarters[i]) << dates[i];
+        EXPECT_EQ(calendar.FiscalPeriod(Date(dates[i])), periods[i]) << dates[i];
+    }
+    EXPECT_EQ(2021, years[1]);
+    EXPECT_EQ(3, quarters[3]);
+}
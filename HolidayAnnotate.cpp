@@ -0,0 +1,96 @@
+/// @file
+/// @brief Command line tool appending is_holiday, is_trading_day and
+///        next_trading_day columns to rows beginning with a yyyymmdd date.
+///
+///        Usage: HolidayAnnotate [-s startYear] [-e endYear] [-d delimiter]
+///                               [-b bufferBytes] [input [output]]
+///
+///        Reads standard input and writes standard output when no files
+///        are given.  Holidays and trading days between startYear and
+///        endYear (1970 and 2070 by default) are cached; other years are
+///        still annotated, just more slowly.
+#include "CalendarAnnotator.hpp"
+#include "USMarketHolidays.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Holiday;
+
+namespace
+{
+
+int Usage()
+{
+    std::fprintf(stderr, "usage: HolidayAnnotate [-s startYear] [-e endYear] [-d delimiter]"
+                         " [-b bufferBytes] [input [output]]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int startYear = 1970;
+    int endYear = 2070;
+    char delimiter = ',';
+    std::size_t bufferSize = 1 << 20;
+    const char* files[2] = { NULL, NULL };
+    int fileCount = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0')
+        {
+            if (i + 1 == argc) return Usage();
+            const char* value = argv[++i];
+            switch (argv[i - 1][1])
+            {
+                case 's': startYear = std::atoi(value); break;
+                case 'e': endYear = std::atoi(value); break;
+                case 'd': delimiter = std::strcmp(value, "\\t") == 0 ? '\t' : value[0]; break;
+                case 'b': bufferSize = std::strtoul(value, NULL, 10); break;
+                default: return Usage();
+            }
+        }
+        else if (fileCount < 2)
+        {
+            files[fileCount++] = argv[i];
+        }
+        else
+        {
+            return Usage();
+        }
+    }
+    if (startYear > endYear) return Usage();
+
+    std::FILE* input = files[0] ? std::fopen(files[0], "rb") : stdin;
+    if (input == NULL)
+    {
+        std::perror(files[0]);
+        return 1;
+    }
+    std::FILE* output = files[1] ? std::fopen(files[1], "wb") : stdout;
+    if (output == NULL)
+    {
+        std::perror(files[1]);
+        return 1;
+    }
+    // the annotator does its own buffering
+    std::setvbuf(input, NULL, _IONBF, 0);
+    std::setvbuf(output, NULL, _IONBF, 0);
+
+    HolidayCalendar<USMarketHolidays> holidays(startYear, endYear);
+    TradingDayCalendar<USMarketHolidays> tradingDays(startYear, endYear);
+    CalendarAnnotator<USMarketHolidays> annotator(holidays, tradingDays, delimiter, bufferSize);
+    if (!annotator.Annotate(input, output))
+    {
+        std::fprintf(stderr, "HolidayAnnotate: failed to annotate input\n");
+        return 1;
+    }
+    if (output != stdout && std::fclose(output) != 0)
+    {
+        std::perror(files[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+/// @file
+/// @brief Implementation of the C interface declared in HolidayC.h
+#include "HolidayC.h"
+#include "HolidayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <new>
+
+using namespace Holiday;
+
+/// @brief Concrete type behind the opaque C handle
+struct holiday_calendar
+{
+    holiday_calendar(int startYear, int endYear)
+        : holidays(startYear, endYear)
+        , tradingDays(startYear, endYear)
+    {
+    }
+    HolidayCalendar<USMarketHolidays> holidays;
+    TradingDayCalendar<USMarketHolidays> tradingDays;
+};
+
+extern "C" {
+
+int holiday_abi_version(void)
+{
+    return HOLIDAY_ABI_VERSION;
+}
+
+holiday_calendar* holiday_calendar_create(int32_t start_year, int32_t end_year)
+{
+    if (start_year > end_year) return NULL;
+    try
+    {
+        return new holiday_calendar(start_year, end_year);
+    }
+    catch (...)
+    {
+        // exceptions must not cross the C boundary
+        return NULL;
+    }
+}
+
+void holiday_calendar_destroy(holiday_calendar* calendar)
+{
+    delete calendar;
+}
+
+int holiday_is_market_holiday(const holiday_calendar* calendar, int32_t yyyymmdd)
+{
+    if (calendar == NULL) return -1;
+    return calendar->holidays.IsMarketHoliday(yyyymmdd) ? 1 : 0;
+}
+
+int holiday_is_trading_day(const holiday_calendar* calendar, int32_t yyyymmdd)
+{
+    if (calendar == NULL) return -1;
+    return calendar->tradingDays.IsTradingDay(yyyymmdd) ? 1 : 0;
+}
+
+int holiday_is_market_holiday_batch(const holiday_calendar* calendar,
+                                    const int32_t* dates,
+                                    size_t count,
+                                    uint8_t* results)
+{
+    if (count == 0) return 0;
+    if (calendar == NULL || dates == NULL || results == NULL) return -1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        results[i] = calendar->holidays.IsMarketHoliday(dates[i]) ? 1 : 0;
+    }
+    return 0;
+}
+
+int holiday_is_trading_day_batch(const holiday_calendar* calendar,
+                                 const int32_t* dates,
+                                 size_t count,
+                                 uint8_t* results)
+{
+    if (count == 0) return 0;
+    if (calendar == NULL || dates == NULL || results == NULL) return -1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        results[i] = calendar->tradingDays.IsTradingDay(dates[i]) ? 1 : 0;
+    }
+    return 0;
+}
+
+} // extern "C"
@@ -0,0 +1,83 @@
+/// @file
+/// @brief Stable C interface to the Holiday calendars for foreign callers
+///        (Python ctypes/cffi, JNI, etc.) built into the libholiday
+///        shared library.
+///
+///        A calendar handle is created once for a range of years and owns
+///        the cached holidays and trading days for that range, so the cost
+///        of building the cache is paid once per handle rather than per
+///        call.  Batch functions operate on contiguous int32 buffers of
+///        yyyymmdd dates so arrays owned by the caller can be passed
+///        without copying.  Dates outside the cached range are still
+///        answered correctly by evaluating the holiday rules directly.
+///
+///        Handles are immutable after creation and may be queried from
+///        several threads at once.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(HOLIDAY_BUILDING_LIBRARY)
+#    define HOLIDAY_API __declspec(dllexport)
+#  else
+#    define HOLIDAY_API __declspec(dllimport)
+#  endif
+#else
+#  define HOLIDAY_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Version of the C ABI.  Incremented on incompatible changes.
+#define HOLIDAY_ABI_VERSION 1
+
+/// @brief Opaque handle to a US market calendar
+typedef struct holiday_calendar holiday_calendar;
+
+/// @brief Returns the ABI version the library was built with
+HOLIDAY_API int holiday_abi_version(void);
+
+/// @brief Creates a US market calendar caching all holidays and trading
+///        days between the given years (inclusive).
+/// @return The new handle, or NULL if the range is invalid or memory
+///         could not be allocated.
+HOLIDAY_API holiday_calendar* holiday_calendar_create(int32_t start_year,
+                                                      int32_t end_year);
+
+/// @brief Releases a handle created by holiday_calendar_create.
+///        Passing NULL is a no-op.
+HOLIDAY_API void holiday_calendar_destroy(holiday_calendar* calendar);
+
+/// @brief Returns 1 if the yyyymmdd date is a market holiday, 0 if not,
+///        or -1 if the handle is NULL.
+HOLIDAY_API int holiday_is_market_holiday(const holiday_calendar* calendar,
+                                          int32_t yyyymmdd);
+
+/// @brief Returns 1 if the yyyymmdd date is a trading day, 0 if not,
+///        or -1 if the handle is NULL.
+HOLIDAY_API int holiday_is_trading_day(const holiday_calendar* calendar,
+                                       int32_t yyyymmdd);
+
+/// @brief Writes 1 to results[i] if dates[i] is a market holiday, else 0.
+/// @return 0 on success or -1 if any pointer argument is NULL
+///         while count is non-zero.
+HOLIDAY_API int holiday_is_market_holiday_batch(const holiday_calendar* calendar,
+                                                const int32_t* dates,
+                                                size_t count,
+                                                uint8_t* results);
+
+/// @brief Writes 1 to results[i] if dates[i] is a trading day, else 0.
+/// @return 0 on success or -1 if any pointer argument is NULL
+///         while count is non-zero.
+HOLIDAY_API int holiday_is_trading_day_batch(const holiday_calendar* calendar,
+                                             const int32_t* dates,
+                                             size_t count,
+                                             uint8_t* results);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
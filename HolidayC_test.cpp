@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "HolidayC.h"
+#include "USMarketHolidays.hpp"
+#include "KnownUSMarketHolidays.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace Holiday;
+
+TEST(HolidayC, AbiVersion)
+{
+    EXPECT_EQ(HOLIDAY_ABI_VERSION, holiday_abi_version());
+}
+
+TEST(HolidayC, CreateInvalidRange)
+{
+    EXPECT_EQ(NULL, holiday_calendar_create(2020, 2010));
+}
+
+TEST(HolidayC, NullHandle)
+{
+    int32_t date = 20200217;
+    uint8_t result = 0;
+    EXPECT_EQ(-1, holiday_is_market_holiday(NULL, date));
+    EXPECT_EQ(-1, holiday_is_trading_day(NULL, date));
+    EXPECT_EQ(-1, holiday_is_market_holiday_batch(NULL, &date, 1, &result));
+    EXPECT_EQ(-1, holiday_is_trading_day_batch(NULL, &date, 1, &result));
+    EXPECT_EQ(0, holiday_is_trading_day_batch(NULL, NULL, 0, NULL));
+    holiday_calendar_destroy(NULL);
+}
+
+TEST(HolidayC, KnownUSMarketHolidaysPartialCache)
+{
+    holiday_calendar* calendar = holiday_calendar_create(2010, 2020);
+    ASSERT_NE(nullptr, calendar);
+    for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    {
+        int yyyymmdd = date;
+        bool isKnownHoliday = std::find(std::begin(KnownUSMarketHolidays),
+                                        std::end(KnownUSMarketHolidays),
+                                        yyyymmdd) != std::end(KnownUSMarketHolidays);
+        bool isTradingDay = !isKnownHoliday && !date.IsWeekend();
+        EXPECT_EQ(isKnownHoliday ? 1 : 0, holiday_is_market_holiday(calendar, yyyymmdd)) << yyyymmdd;
+        EXPECT_EQ(isTradingDay ? 1 : 0, holiday_is_trading_day(calendar, yyyymmdd)) << yyyymmdd;
+    }
+    holiday_calendar_destroy(calendar);
+}
+
+TEST(HolidayC, BatchMatchesScalar)
+{
+    holiday_calendar* calendar = holiday_calendar_create(2010, 2020);
+    ASSERT_NE(nullptr, calendar);
+    std::vector<int32_t> dates;
+    for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    {
+        dates.push_back(date);
+    }
+    std::vector<uint8_t> holidays(dates.size());
+    std::vector<uint8_t> tradingDays(dates.size());
+    ASSERT_EQ(0, holiday_is_market_holiday_batch(calendar, dates.data(), dates.size(), holidays.data()));
+    ASSERT_EQ(0, holiday_is_trading_day_batch(calendar, dates.data(), dates.size(), tradingDays.data()));
+    for (size_t i = 0; i < dates.size(); ++i)
+    {
+        EXPECT_EQ(holiday_is_market_holiday(calendar, dates[i]), holidays[i]) << dates[i];
+        EXPECT_EQ(holiday_is_trading_day(calendar, dates[i]), tradingDays[i]) << dates[i];
+    }
+    holiday_calendar_destroy(calendar);
+}
@@ -1,14 +1,19 @@
 #pragma once
 
 #include "Date.hpp"
-#include <unordered_set>
+#include "HolidayStorage.hpp"
+#include "Profile.hpp"
+#include <cstddef>
 
 namespace Holiday
 {
 
 /// @brief A class that can cache holdays using a provided template parameter
-/// to query if the date is a holiday.
-template <class Holidays>
+/// to query if the date is a holiday.  The Storage template parameter
+/// selects how the cached holidays are held, see HolidayStorage.hpp.
+///
+/// Copies are deep; moves only transfer the storage and never allocate.
+template <class Holidays, class Storage = HashHolidayStorage>
 class HolidayCalendar
 {
 public:
@@ -16,6 +21,16 @@ public:
     HolidayCalendar();
     /// @brief Create a calendar caching all holidays between the given years
     HolidayCalendar(int startYear, int endYear);
+    /// @brief Creates a calendar with no cache that caches into storage,
+    ///        e.g. one using an ArenaAllocator
+    explicit HolidayCalendar(const Storage& storage);
+    /// @brief Create a calendar caching all holidays between the given
+    ///        years into storage
+    HolidayCalendar(int startYear, int endYear, const Storage& storage);
+    HolidayCalendar(const HolidayCalendar&) = default;
+    HolidayCalendar(HolidayCalendar&&) = default;
+    HolidayCalendar& operator=(const HolidayCalendar&) = default;
+    HolidayCalendar& operator=(HolidayCalendar&&) = default;
     /// @brief Caches all holidays between the provided years
     void Cache(int startYear, int endYear);
     /// @brief Returns true if the provided date is a holiday
@@ -24,67 +39,85 @@ public:
     bool IsMarketHoliday(int yyyymmdd) const;
     /// @brief Returns true if the provided date is a holiday
     bool IsMarketHoliday(const Date& date) const;
+    /// @brief Writes IsMarketHoliday of count yyyymmdd dates to results
+    void IsMarketHoliday(const int* dates, std::size_t count, bool* results) const;
+    /// @brief Approximate number of bytes allocated by the cache
+    std::size_t MemoryUsage() const;
 private:
     bool IsCached(const Date& date) const;
-    std::unordered_set<int> m_CachedHolidays;
+    Storage m_CachedHolidays;
     int m_StartYear;
     int m_EndYear;
 };
 
-template <class Holidays>
-HolidayCalendar<Holidays>::HolidayCalendar()
+template <class Holidays, class Storage>
+HolidayCalendar<Holidays, Storage>::HolidayCalendar()
 {
     // no cache
     m_StartYear = 0;
     m_EndYear = -1;
 }
-template <class Holidays>
-HolidayCalendar<Holidays>::HolidayCalendar(int startYear, int endYear)
+template <class Holidays, class Storage>
+HolidayCalendar<Holidays, Storage>::HolidayCalendar(int startYear, int endYear)
 {
     Cache(startYear, endYear);
 }
-template <class Holidays>
-void HolidayCalendar<Holidays>::Cache(int startYear, int endYear)
+template <class Holidays, class Storage>
+HolidayCalendar<Holidays, Storage>::HolidayCalendar(const Storage& storage)
+    : m_CachedHolidays(storage)
 {
+    // no cache
+    m_StartYear = 0;
+    m_EndYear = -1;
+}
+template <class Holidays, class Storage>
+HolidayCalendar<Holidays, Storage>::HolidayCalendar(int startYear, int endYear, const Storage& storage)
+    : m_CachedHolidays(storage)
+{
+    Cache(startYear, endYear);
+}
+template <class Holidays, class Storage>
+void HolidayCalendar<Holidays, Storage>::Cache(int startYear, int endYear)
+{
+    HOLIDAY_PROFILE_SCOPE(ProfileProbe::CacheHolidays);
     m_StartYear = startYear;
     m_EndYear = endYear;
-    for(Date date(startYear,1,1); date.Year() <= endYear; date = date.GetNextDay())
-    {
-        if (Holidays::IsMarketHoliday(date))
-        {
-            m_CachedHolidays.insert(date);
-        }
-    }
+    // selects the scalar overload where Holidays also has a batch form
+    bool (*isHoliday)(const Date&) = &Holidays::IsMarketHoliday;
+    m_CachedHolidays.Cache(startYear, endYear, isHoliday);
 }
-template <class Holidays>
-bool HolidayCalendar<Holidays>::IsCached(const Date& date) const
+template <class Holidays, class Storage>
+bool HolidayCalendar<Holidays, Storage>::IsCached(const Date& date) const
 {
-    return date.Year() >= m_StartYear && date.Year() <= m_EndYear;
+    return date.Valid() && date.Year() >= m_StartYear && date.Year() <= m_EndYear;
 }
-template<class Holidays>
-bool HolidayCalendar<Holidays>::IsMarketHoliday(int year, int month, int day) const
+template <class Holidays, class Storage>
+bool HolidayCalendar<Holidays, Storage>::IsMarketHoliday(int year, int month, int day) const
 {
-    Date date(year, month, day);
-    int yyyymmdd = date;
-    return IsCached(date)
-        ? m_CachedHolidays.count(yyyymmdd) != 0
-        : Holidays::IsMarketHoliday(date);
+    return IsMarketHoliday(Date(year, month, day));
 }
-template<class Holidays>
-bool HolidayCalendar<Holidays>::IsMarketHoliday(int yyyymmdd) const
+template <class Holidays, class Storage>
+bool HolidayCalendar<Holidays, Storage>::IsMarketHoliday(int yyyymmdd) const
 {
-    Date date(yyyymmdd);
-    return IsCached(date)
-        ? m_CachedHolidays.count(yyyymmdd) != 0
-        : Holidays::IsMarketHoliday(date);
+    return IsMarketHoliday(Date(yyyymmdd));
 }
-template<class Holidays>
-bool HolidayCalendar<Holidays>::IsMarketHoliday(const Date& date) const
+template <class Holidays, class Storage>
+bool HolidayCalendar<Holidays, Storage>::IsMarketHoliday(const Date& date) const
 {
-    int yyyymmdd = date;
+    HOLIDAY_PROFILE_SCOPE(ProfileProbe::IsMarketHoliday);
     return IsCached(date)
-        ? m_CachedHolidays.count(yyyymmdd) != 0
+        ? m_CachedHolidays.Contains(date)
         : Holidays::IsMarketHoliday(date);
 }
+template <class Holidays, class Storage>
+void HolidayCalendar<Holidays, Storage>::IsMarketHoliday(const int* dates, std::size_t count, bool* results) const
+{
+    for (std::size_t i = 0; i < count; ++i) results[i] = IsMarketHoliday(Date(dates[i]));
+}
+template <class Holidays, class Storage>
+std::size_t HolidayCalendar<Holidays, Storage>::MemoryUsage() const
+{
+    return m_CachedHolidays.MemoryUsage();
+}
 
 } // namespace Holiday
@@ -0,0 +1,96 @@
+/// @file
+/// @brief Compares the memory used and the query latency of the
+///        HolidayCalendar storage policies for increasingly wide
+///        cached ranges, and the query latency of evaluating the rules
+///        without a cache one date or one batch at a time.
+///
+///        Usage: HolidayCalendar_benchmark [queries]
+#include "HolidayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+template <class Storage>
+void Report(const char* name, int startYear, int endYear, const std::vector<int>& dates)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    HolidayCalendar<USMarketHolidays, Storage> calendar(startYear, endYear);
+    std::chrono::duration<double> build = std::chrono::steady_clock::now() - start;
+
+    long count = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < dates.size(); ++i)
+    {
+        count += calendar.IsMarketHoliday(dates[i]) ? 1 : 0;
+    }
+    std::chrono::duration<double, std::nano> query = std::chrono::steady_clock::now() - start;
+
+    std::printf("%-8s %6d %12.3f %12zu %10.1f %8ld\n", name, endYear - startYear + 1,
+                build.count() * 1000, calendar.MemoryUsage(),
+                query.count() / dates.size(), count);
+}
+
+/// Evaluates the rules without a cache, one date at a time or in batches
+void ReportRules(int startYear, int endYear, const std::vector<int>& dates)
+{
+    long scalarCount = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < dates.size(); ++i)
+    {
+        scalarCount += USMarketHolidays::IsMarketHoliday(Date(dates[i])) ? 1 : 0;
+    }
+    std::chrono::duration<double, std::nano> scalar = std::chrono::steady_clock::now() - start;
+
+    const size_t batchSize = 1024;
+    bool results[batchSize];
+    long batchCount = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t begin = 0; begin < dates.size(); begin += batchSize)
+    {
+        size_t count = std::min(batchSize, dates.size() - begin);
+        USMarketHolidays::IsMarketHoliday(&dates[begin], count, results);
+        for (size_t i = 0; i < count; ++i) batchCount += results[i] ? 1 : 0;
+    }
+    std::chrono::duration<double, std::nano> batch = std::chrono::steady_clock::now() - start;
+
+    std::printf("%-8s %6d %12.3f %12zu %10.1f %8ld\n", "rules", endYear - startYear + 1,
+                0.0, size_t(0), scalar.count() / dates.size(), scalarCount);
+    std::printf("%-8s %6d %12.3f %12zu %10.1f %8ld\n", "batch", endYear - startYear + 1,
+                0.0, size_t(0), batch.count() / dates.size(), batchCount);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int queries = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int spans[] = { 41, 400, 4000 };
+    std::printf("%-8s %6s %12s %12s %10s %8s\n",
+                "storage", "years", "build ms", "bytes", "ns/query", "hits");
+    for (size_t s = 0; s < sizeof(spans) / sizeof(spans[0]); ++s)
+    {
+        int startYear = 2000 - spans[s] / 2;
+        int endYear = startYear + spans[s] - 1;
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> days(Date(startYear,1,1).DaysSinceEpoch(),
+                                                Date(endYear,12,31).DaysSinceEpoch());
+        std::vector<int> dates;
+        for (int i = 0; i < queries; ++i)
+        {
+            dates.push_back(Date::FromDaysSinceEpoch(days(generator)));
+        }
+        Report<HashHolidayStorage>("hash", startYear, endYear, dates);
+        Report<SortedHolidayStorage>("sorted", startYear, endYear, dates);
+        ReportRules(startYear, endYear, dates);
+    }
+    return 0;
+}
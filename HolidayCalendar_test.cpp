@@ -44,3 +44,63 @@ TEST(HolidayCalendar, KnownUSMarketHolidaysNoCache)
         EXPECT_EQ(isKnownHoliday, calendar.IsMarketHoliday(date)) << yyyymmdd;
     }
 }
+
+TEST(HolidayCalendar, KnownUSMarketHolidaysSortedStorage)
+{
+    HolidayCalendar<USMarketHolidays, SortedHolidayStorage> calendar(2010,2020);
+    for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    {
+        int yyyymmdd = date;
+        bool isKnownHoliday = std::find(std::begin(KnownUSMarketHolidays),
+                                        std::end(KnownUSMarketHolidays),
+                                        yyyymmdd) != std::end(KnownUSMarketHolidays);
+        EXPECT_EQ(isKnownHoliday, calendar.IsMarketHoliday(date)) << yyyymmdd;
+    }
+}
+
+TEST(HolidayCalendar, EmptyOrReversedRange)
+{
+    HolidayCalendar<USMarketHolidays, SortedHolidayStorage> reversed(2020,2010);
+    HolidayCalendar<USMarketHolidays> hashReversed(2020,2010);
+    EXPECT_TRUE(reversed.IsMarketHoliday(20150101));
+    EXPECT_FALSE(reversed.IsMarketHoliday(20150102));
+    EXPECT_TRUE(hashReversed.IsMarketHoliday(20150101));
+    reversed.Cache(0,-5);
+    EXPECT_TRUE(reversed.IsMarketHoliday(20151225));
+    EXPECT_FALSE(reversed.IsMarketHoliday(20151224));
+}
+
+TEST(HolidayCalendar, InvalidDates)
+{
+    HolidayCalendar<USMarketHolidays> hashCalendar(2000,2040);
+    HolidayCalendar<USMarketHolidays, SortedHolidayStorage> sortedCalendar(2000,2040);
+    HolidayCalendar<USMarketHolidays> noCache;
+    const int dates[] = { 20201401, 20200132, 20210229, 20200100, -1 };
+    for (size_t i = 0; i < sizeof(dates) / sizeof(dates[0]); ++i)
+    {
+        EXPECT_FALSE(hashCalendar.IsMarketHoliday(dates[i])) << dates[i];
+        EXPECT_FALSE(sortedCalendar.IsMarketHoliday(dates[i])) << dates[i];
+        EXPECT_FALSE(noCache.IsMarketHoliday(dates[i])) << dates[i];
+    }
+}
+
+TEST(HolidayCalendar, QueryBatch)
+{
+    HolidayCalendar<USMarketHolidays> calendar(2020,2020);
+    const int dates[] = { 20200101, 20200102, 20210101, 20201301 };
+    bool holidays[4];
+    calendar.IsMarketHoliday(dates, 4, holidays);
+    const bool expected[] = { true, false, true, false };
+    EXPECT_TRUE(std::equal(holidays, holidays + 4, expected));
+}
+
+TEST(HolidayCalendar, SortedStorageIsCompact)
+{
+    HolidayCalendar<USMarketHolidays> hashCalendar(2000,2040);
+    HolidayCalendar<USMarketHolidays, SortedHolidayStorage> sortedCalendar(2000,2040);
+    HolidayCalendar<USMarketHolidays, SortedHolidayStorage> noCache;
+    size_t holidays = std::end(KnownUSMarketHolidays) - std::begin(KnownUSMarketHolidays);
+    EXPECT_EQ(0u, noCache.MemoryUsage());
+    EXPECT_LE(sortedCalendar.MemoryUsage(), holidays * 2 * 2 + 42 * 4 * 2);
+    EXPECT_LT(sortedCalendar.MemoryUsage(), hashCalendar.MemoryUsage());
+}
@@ -0,0 +1,143 @@
+/// @file
+/// @brief Command line tool writing the header that defines the
+///        StaticTradingDayTables of USMarketHolidays with a Saturday and
+///        Sunday weekend for a range of years.
+///
+///        Usage: HolidayGenerate [-s startYear] [-e endYear] [output]
+///
+///        Writes standard output when no file is given.  The years default
+///        to 2000 and 2050.  Include the header to use
+///        StaticTradingDayCalendar<USMarketHolidays, startYear, endYear>.
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+int Usage()
+{
+    std::fprintf(stderr, "usage: HolidayGenerate [-s startYear] [-e endYear] [output]\n");
+    return 2;
+}
+
+bool Write(std::FILE* file, int startYear, int endYear)
+{
+    TradingDayCalendar<USMarketHolidays> calendar;
+    int startDay = Date(startYear,1,1).DaysSinceEpoch();
+    int days = Date(endYear + 1,1,1).DaysSinceEpoch() - startDay;
+    std::vector<std::uint64_t> tradingDays((days + 63) / 64, 0);
+    std::vector<std::uint32_t> ranks(tradingDays.size(), 0);
+    int day = 0;
+    for (Date date(startYear,1,1); day < days; date = date.GetNextDay(), ++day)
+    {
+        if (calendar.IsTradingDay(date)) tradingDays[day / 64] |= std::uint64_t(1) << (day % 64);
+    }
+    std::uint32_t tradingDayCount = 0;
+    for (std::size_t word = 0; word < tradingDays.size(); ++word)
+    {
+        ranks[word] = tradingDayCount;
+        tradingDayCount += PopCount(tradingDays[word]);
+    }
+
+    std::fprintf(file,
+        "/// @file\n"
+        "/// @brief StaticTradingDayTables of USMarketHolidays from %d to %d.\n"
+        "///        Generated by HolidayGenerate, do not edit.\n"
+        "#pragma once\n"
+        "\n"
+        "#include \"StaticTradingDayCalendar.hpp\"\n"
+        "#include \"USMarketHolidays.hpp\"\n"
+        "\n"
+        "namespace Holiday\n"
+        "{\n"
+        "\n"
+        "template <>\n"
+        "struct StaticTradingDayTables<USMarketHolidays, SaturdaySundayWeekend, %d, %d>\n"
+        "{\n"
+        "    static const int StartDay = %d;\n"
+        "    static const int Days = %d;\n"
+        "    static const int TradingDayCount = %u;\n"
+        "    static const std::uint64_t* TradingDays()\n"
+        "    {\n"
+        "        static const std::uint64_t tradingDays[] =\n"
+        "        {",
+        startYear, endYear, startYear, endYear, startDay, days, static_cast<unsigned>(tradingDayCount));
+    for (std::size_t word = 0; word < tradingDays.size(); ++word)
+    {
+        std::fprintf(file, "%s0x%016llxull,", word % 4 == 0 ? "\n            " : " ",
+                     static_cast<unsigned long long>(tradingDays[word]));
+    }
+    std::fprintf(file,
+        "\n"
+        "        };\n"
+        "        return tradingDays;\n"
+        "    }\n"
+        "    static const std::uint32_t* Ranks()\n"
+        "    {\n"
+        "        static const std::uint32_t ranks[] =\n"
+        "        {");
+    for (std::size_t word = 0; word < ranks.size(); ++word)
+    {
+        std::fprintf(file, "%s%u,", word % 8 == 0 ? "\n            " : " ", static_cast<unsigned>(ranks[word]));
+    }
+    std::fprintf(file,
+        "\n"
+        "        };\n"
+        "        return ranks;\n"
+        "    }\n"
+        "};\n"
+        "\n"
+        "} // namespace Holiday\n");
+    return !std::ferror(file);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int startYear = 2000;
+    int endYear = 2050;
+    const char* file = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0')
+        {
+            if (i + 1 == argc) return Usage();
+            const char* value = argv[++i];
+            switch (argv[i - 1][1])
+            {
+                case 's': startYear = std::atoi(value); break;
+                case 'e': endYear = std::atoi(value); break;
+                default: return Usage();
+            }
+        }
+        else if (file == NULL)
+        {
+            file = argv[i];
+        }
+        else
+        {
+            return Usage();
+        }
+    }
+    if (startYear > endYear) return Usage();
+
+    std::FILE* output = file ? std::fopen(file, "w") : stdout;
+    if (output == NULL)
+    {
+        std::perror(file);
+        return 1;
+    }
+    if (!Write(output, startYear, endYear) || (output != stdout && std::fclose(output) != 0))
+    {
+        std::fprintf(stderr, "HolidayGenerate: failed to write tables\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/// @file
+/// @brief Storage policies used by Holiday::HolidayCalendar to hold
+///        the cached holidays.
+///
+///        Each policy takes a standard allocator, e.g. an ArenaAllocator,
+///        used for all of its memory.  Cache() frees the previous contents
+///        and pre-sizes its containers so a typical calendar is cached
+///        with a constant number of allocations (plus one per holiday for
+///        the hash set's nodes).
+#pragma once
+
+#include "Date.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace Holiday
+{
+
+/// @brief Number of holidays per year the storage policies pre-size for.
+///        Policies with more holidays still work, with a few more
+///        allocations while caching.
+static const int ExpectedHolidaysPerYear = 12;
+
+/// @brief Stores cached holidays in a hash set of yyyymmdd values.
+template <class Allocator = std::allocator<int> >
+class BasicHashHolidayStorage
+{
+public:
+    explicit BasicHashHolidayStorage(const Allocator& allocator = Allocator());
+    /// @brief Replaces the contents with all dates between the provided
+    ///        years for which isHoliday returns true
+    template <class IsHoliday>
+    void Cache(int startYear, int endYear, IsHoliday isHoliday);
+    /// @brief Returns true if the valid date, within the cached years,
+    ///        was cached as a holiday
+    bool Contains(const Date& date) const;
+    /// @brief Approximate number of bytes allocated by the storage
+    std::size_t MemoryUsage() const;
+private:
+    typedef std::unordered_set<int, std::hash<int>, std::equal_to<int>, Allocator> Set_t;
+    Set_t m_Holidays;
+};
+typedef BasicHashHolidayStorage<> HashHolidayStorage;
+
+/// @brief Stores cached holidays as a sorted array of 16-bit day-of-year
+///        values with a per-year offset table into it.  Uses about two
+///        bytes per holiday plus four bytes per year, and a query reads
+///        one offset pair and the few holidays of that year, which fit
+///        in a single cache line.
+template <class Allocator = std::allocator<std::uint16_t> >
+class BasicSortedHolidayStorage
+{
+public:
+    explicit BasicSortedHolidayStorage(const Allocator& allocator = Allocator());
+    /// @brief Replaces the contents with all dates between the provided
+    ///        years for which isHoliday returns true
+    template <class IsHoliday>
+    void Cache(int startYear, int endYear, IsHoliday isHoliday);
+    /// @brief Returns true if the valid date, within the cached years,
+    ///        was cached as a holiday
+    bool Contains(const Date& date) const;
+    /// @brief Approximate number of bytes allocated by the storage
+    std::size_t MemoryUsage() const;
+private:
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t> OffsetAllocator_t;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint16_t> DayAllocator_t;
+    int m_StartYear;
+    /// index into m_DaysOfYear of the first holiday of each year,
+    /// followed by the total number of holidays
+    std::vector<std::uint32_t, OffsetAllocator_t> m_YearOffsets;
+    std::vector<std::uint16_t, DayAllocator_t> m_DaysOfYear;
+};
+typedef BasicSortedHolidayStorage<> SortedHolidayStorage;
+
+template <class Allocator>
+BasicHashHolidayStorage<Allocator>::BasicHashHolidayStorage(const Allocator& allocator)
+    : m_Holidays(0, std::hash<int>(), std::equal_to<int>(), allocator)
+{
+}
+template <class Allocator>
+template <class IsHoliday>
+void BasicHashHolidayStorage<Allocator>::Cache(int startYear, int endYear, IsHoliday isHoliday)
+{
+    // start from an empty set so buckets of a previous, wider range are freed
+    Set_t(0, std::hash<int>(), std::equal_to<int>(), m_Holidays.get_allocator()).swap(m_Holidays);
+    if (startYear <= endYear)
+    {
+        m_Holidays.reserve(static_cast<std::size_t>(endYear - startYear + 1) * ExpectedHolidaysPerYear);
+    }
+    for(Date date(startYear,1,1); date.Year() <= endYear; date = date.GetNextDay())
+    {
+        if (isHoliday(date))
+        {
+            m_Holidays.insert(date);
+        }
+    }
+}
+template <class Allocator>
+bool BasicHashHolidayStorage<Allocator>::Contains(const Date& date) const
+{
+    return m_Holidays.count(date) != 0;
+}
+template <class Allocator>
+std::size_t BasicHashHolidayStorage<Allocator>::MemoryUsage() const
+{
+    // one pointer per bucket plus a node holding a pointer and the value
+    return m_Holidays.bucket_count() * sizeof(void*)
+         + m_Holidays.size() * (sizeof(void*) + sizeof(int));
+}
+
+template <class Allocator>
+BasicSortedHolidayStorage<Allocator>::BasicSortedHolidayStorage(const Allocator& allocator)
+    : m_YearOffsets(OffsetAllocator_t(allocator))
+    , m_DaysOfYear(DayAllocator_t(allocator))
+{
+    m_StartYear = 0;
+}
+template <class Allocator>
+template <class IsHoliday>
+void BasicSortedHolidayStorage<Allocator>::Cache(int startYear, int endYear, IsHoliday isHoliday)
+{
+    m_StartYear = startYear;
+    // start from empty vectors so memory of a previous, wider range is freed
+    std::vector<std::uint32_t, OffsetAllocator_t>(m_YearOffsets.get_allocator()).swap(m_YearOffsets);
+    std::vector<std::uint16_t, DayAllocator_t>(m_DaysOfYear.get_allocator()).swap(m_DaysOfYear);
+    if (startYear <= endYear)
+    {
+        std::size_t years = static_cast<std::size_t>(endYear - startYear + 1);
+        m_YearOffsets.reserve(years + 1);
+        m_DaysOfYear.reserve(years * ExpectedHolidaysPerYear);
+    }
+    for (int year = startYear; year <= endYear; ++year)
+    {
+        m_YearOffsets.push_back(static_cast<std::uint32_t>(m_DaysOfYear.size()));
+        int dayOfYear = 1;
+        for (Date date(year,1,1); date.Year() == year; date = date.GetNextDay(), ++dayOfYear)
+        {
+            if (isHoliday(date))
+            {
+                m_DaysOfYear.push_back(static_cast<std::uint16_t>(dayOfYear));
+            }
+        }
+    }
+    m_YearOffsets.push_back(static_cast<std::uint32_t>(m_DaysOfYear.size()));
+}
+template <class Allocator>
+bool BasicSortedHolidayStorage<Allocator>::Contains(const Date& date) const
+{
+    int index = date.Year() - m_StartYear;
+    std::uint16_t dayOfYear = static_cast<std::uint16_t>(date.DayOfYear());
+    const std::uint16_t* begin = m_DaysOfYear.data() + m_YearOffsets[index];
+    const std::uint16_t* end = m_DaysOfYear.data() + m_YearOffsets[index + 1];
+    for (; begin != end; ++begin)
+    {
+        if (*begin >= dayOfYear) return *begin == dayOfYear;
+    }
+    return false;
+}
+template <class Allocator>
+std::size_t BasicSortedHolidayStorage<Allocator>::MemoryUsage() const
+{
+    return m_YearOffsets.capacity() * sizeof(std::uint32_t)
+         + m_DaysOfYear.capacity() * sizeof(std::uint16_t);
+}
+
+} // namespace Holiday
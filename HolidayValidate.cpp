@@ -0,0 +1,105 @@
+/// @file
+/// @brief Command line tool comparing the US market holidays generated by
+///        USMarketHolidays with a reference list of yyyymmdd dates.
+///
+///        Usage: HolidayValidate [-s startYear] [-e endYear] [reference]
+///
+///        Reads the reference list from standard input when no file is
+///        given; see CalendarValidator::ReadReference for its format.  The
+///        years default to those spanned by the reference list.  Prints
+///        the missing and extra holidays of each year that differs and
+///        exits with 1 if any year differs.
+#include "CalendarValidator.hpp"
+#include "USMarketHolidays.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+int Usage()
+{
+    std::fprintf(stderr, "usage: HolidayValidate [-s startYear] [-e endYear] [reference]\n");
+    return 2;
+}
+
+void PrintDates(const char* label, const std::vector<int>& dates)
+{
+    if (dates.empty()) return;
+    std::printf(" %s", label);
+    for (std::size_t i = 0; i < dates.size(); ++i)
+    {
+        std::printf(" %d", dates[i]);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    bool hasStartYear = false;
+    bool hasEndYear = false;
+    int startYear = 0;
+    int endYear = 0;
+    const char* file = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0')
+        {
+            if (i + 1 == argc) return Usage();
+            const char* value = argv[++i];
+            switch (argv[i - 1][1])
+            {
+                case 's': startYear = std::atoi(value); hasStartYear = true; break;
+                case 'e': endYear = std::atoi(value); hasEndYear = true; break;
+                default: return Usage();
+            }
+        }
+        else if (file == NULL)
+        {
+            file = argv[i];
+        }
+        else
+        {
+            return Usage();
+        }
+    }
+
+    std::FILE* input = file ? std::fopen(file, "rb") : stdin;
+    if (input == NULL)
+    {
+        std::perror(file);
+        return 1;
+    }
+    std::vector<int> reference;
+    if (!CalendarValidator<USMarketHolidays>::ReadReference(input, reference))
+    {
+        std::fprintf(stderr, "HolidayValidate: failed to read reference list\n");
+        return 1;
+    }
+    if (reference.empty())
+    {
+        std::fprintf(stderr, "HolidayValidate: empty reference list\n");
+        return 1;
+    }
+    if (!hasStartYear) startYear = *std::min_element(reference.begin(), reference.end()) / 10000;
+    if (!hasEndYear) endYear = *std::max_element(reference.begin(), reference.end()) / 10000;
+    if (startYear > endYear) return Usage();
+
+    CalendarValidator<USMarketHolidays> validator(startYear, endYear);
+    std::vector<YearDifferences> differences = validator.Validate(reference);
+    for (std::size_t i = 0; i < differences.size(); ++i)
+    {
+        std::printf("%d:", differences[i].year);
+        PrintDates("missing", differences[i].missing);
+        PrintDates("extra", differences[i].extra);
+        std::printf("\n");
+    }
+    std::printf("%d-%d: %u of %d years differ\n", startYear, endYear,
+                static_cast<unsigned>(differences.size()), endYear - startYear + 1);
+    return differences.empty() ? 0 : 1;
+}
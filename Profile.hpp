@@ -0,0 +1,368 @@
+/// @file
+/// @brief Defines Holiday::Profile which records per-thread latency
+///        histograms of the calendar queries and cache builds.
+///
+///        Recording is compiled in only when HOLIDAY_PROFILE is defined,
+///        e.g. by configuring with -DHOLIDAY_PROFILE=ON.  Otherwise
+///        HOLIDAY_PROFILE_SCOPE expands to nothing and the calendars carry
+///        no profiling code at all; the dump functions then report empty
+///        histograms.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace Holiday
+{
+
+typedef int ProfileProbe_t;
+namespace ProfileProbe
+{
+    static const ProfileProbe_t IsMarketHoliday = 0;
+    static const ProfileProbe_t IsTradingDay = 1;
+    static const ProfileProbe_t GetNextTradingDay = 2;
+    static const ProfileProbe_t CacheHolidays = 3;
+    static const ProfileProbe_t CacheTradingDays = 4;
+    static const ProfileProbe_t Count = 5;
+}
+
+/// @brief Histogram of latencies in nanoseconds with buckets of about 6%
+///        width, in the style of an HDR histogram: values below 16 have
+///        their own bucket and every power of two above is split into 16
+///        buckets, so any 64-bit value is recorded in under 1000 buckets.
+class LatencyHistogram
+{
+public:
+    static const int SubBuckets = 16;
+    static const int Buckets = SubBuckets + (64 - 4) * SubBuckets;
+    inline LatencyHistogram();
+    /// @brief Records one latency
+    inline void Record(std::uint64_t nanoseconds);
+    /// @brief Adds the counts of other to this histogram
+    inline void Merge(const LatencyHistogram& other);
+    /// @brief Number of latencies recorded
+    inline std::uint64_t Count() const;
+    /// @brief Sum of the latencies recorded
+    inline std::uint64_t Sum() const;
+    /// @brief Number of latencies recorded in bucket
+    inline std::uint64_t BucketCount(int bucket) const;
+    /// @brief Highest latency at or below which the given percentage of
+    ///        latencies fall, to the bucket's precision, or 0 when empty
+    inline std::uint64_t Percentile(double percent) const;
+    /// @brief Bucket recording the latency
+    static inline int BucketOf(std::uint64_t nanoseconds);
+    /// @brief Lowest latency recorded in bucket
+    static inline std::uint64_t BucketLowest(int bucket);
+    /// @brief Highest latency recorded in bucket
+    static inline std::uint64_t BucketHighest(int bucket);
+private:
+    friend class Profile;
+    std::vector<std::uint64_t> m_Counts;
+    std::uint64_t m_Sum;
+};
+
+/// @brief Process-wide latency histograms per ProfileProbe.
+///
+///        Each thread records into its own histograms without locking;
+///        the counters are relaxed atomics with a single writer so a dump
+///        may read them while other threads record.  A lock is only taken
+///        when a thread records for the first time, when it exits, and by
+///        Snapshot() and Reset().
+class Profile
+{
+public:
+    /// @brief Records a latency for the probe on the calling thread
+    static inline void Record(ProfileProbe_t probe, std::uint64_t nanoseconds);
+    /// @brief Merged histogram of every thread, including exited threads
+    static inline LatencyHistogram Snapshot(ProfileProbe_t probe);
+    /// @brief Clears every histogram
+    static inline void Reset();
+    /// @brief Name of the probe, e.g. "IsTradingDay"
+    static inline const char* Name(ProfileProbe_t probe);
+    /// @brief Writes a line of statistics per probe
+    static inline void DumpText(std::FILE* file);
+    /// @brief Writes the statistics and non-empty buckets of every probe
+    ///        as a JSON object
+    static inline void DumpJson(std::FILE* file);
+
+    /// @brief Records the lifetime of the scope for a probe
+    class Scope
+    {
+    public:
+        explicit Scope(ProfileProbe_t probe)
+            : m_Probe(probe)
+            , m_Start(std::chrono::steady_clock::now())
+        {
+        }
+        ~Scope()
+        {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - m_Start;
+            Record(m_Probe, static_cast<std::uint64_t>(elapsed.count()));
+        }
+    private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+        ProfileProbe_t m_Probe;
+        std::chrono::steady_clock::time_point m_Start;
+    };
+private:
+    struct ThreadHistograms
+    {
+        std::atomic<std::uint64_t> counts[ProfileProbe::Count][LatencyHistogram::Buckets];
+        std::atomic<std::uint64_t> sums[ProfileProbe::Count];
+    };
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<ThreadHistograms*> threads;
+        /// histograms of threads that have exited
+        LatencyHistogram retired[ProfileProbe::Count];
+    };
+    /// registers the thread's histograms and retires them when it exits
+    struct ThreadRegistration
+    {
+        inline ThreadRegistration();
+        inline ~ThreadRegistration();
+        ThreadHistograms* histograms;
+    };
+    static inline Registry& GetRegistry();
+    static inline ThreadHistograms& Local();
+    static inline void Add(LatencyHistogram& histogram, const ThreadHistograms& thread, ProfileProbe_t probe);
+    static inline void DumpStatistics(std::FILE* file, const LatencyHistogram& histogram, const char* format);
+};
+
+#ifdef HOLIDAY_PROFILE
+/// @brief Records the latency of the enclosing scope for the probe
+#define HOLIDAY_PROFILE_SCOPE(probe) ::Holiday::Profile::Scope holidayProfileScope(probe)
+#else
+#define HOLIDAY_PROFILE_SCOPE(probe) ((void)0)
+#endif
+
+LatencyHistogram::LatencyHistogram()
+    : m_Counts(Buckets, 0)
+{
+    m_Sum = 0;
+}
+void LatencyHistogram::Record(std::uint64_t nanoseconds)
+{
+    ++m_Counts[BucketOf(nanoseconds)];
+    m_Sum += nanoseconds;
+}
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+    for (int bucket = 0; bucket < Buckets; ++bucket) m_Counts[bucket] += other.m_Counts[bucket];
+    m_Sum += other.m_Sum;
+}
+std::uint64_t LatencyHistogram::Count() const
+{
+    std::uint64_t count = 0;
+    for (int bucket = 0; bucket < Buckets; ++bucket) count += m_Counts[bucket];
+    return count;
+}
+std::uint64_t LatencyHistogram::Sum() const
+{
+    return m_Sum;
+}
+std::uint64_t LatencyHistogram::BucketCount(int bucket) const
+{
+    return m_Counts[bucket];
+}
+std::uint64_t LatencyHistogram::Percentile(double percent) const
+{
+    std::uint64_t count = Count();
+    if (count == 0) return 0;
+    std::uint64_t rank = static_cast<std::uint64_t>(percent / 100.0 * count + 0.5);
+    if (rank < 1) rank = 1;
+    std::uint64_t seen = 0;
+    for (int bucket = 0; bucket < Buckets; ++bucket)
+    {
+        seen += m_Counts[bucket];
+        if (seen >= rank) return BucketHighest(bucket);
+    }
+    return BucketHighest(Buckets - 1);
+}
+int LatencyHistogram::BucketOf(std::uint64_t nanoseconds)
+{
+    if (nanoseconds < SubBuckets) return static_cast<int>(nanoseconds);
+    int highestBit = 0;
+    for (std::uint64_t value = nanoseconds; value > 1; value >>= 1) ++highestBit;
+    // keep the top 5 bits: the power of two and a 4 bit sub-bucket
+    int shift = highestBit - 4;
+    return (shift + 1) * SubBuckets + static_cast<int>(nanoseconds >> shift) - SubBuckets;
+}
+std::uint64_t LatencyHistogram::BucketLowest(int bucket)
+{
+    if (bucket < SubBuckets) return bucket;
+    int shift = bucket / SubBuckets - 1;
+    return static_cast<std::uint64_t>(SubBuckets + bucket % SubBuckets) << shift;
+}
+std::uint64_t LatencyHistogram::BucketHighest(int bucket)
+{
+    if (bucket < SubBuckets) return bucket;
+    int shift = bucket / SubBuckets - 1;
+    return BucketLowest(bucket) + ((std::uint64_t(1) << shift) - 1);
+}
+
+Profile::ThreadRegistration::ThreadRegistration()
+{
+    histograms = new ThreadHistograms();
+    for (int probe = 0; probe < ProfileProbe::Count; ++probe)
+    {
+        for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+        {
+            histograms->counts[probe][bucket].store(0, std::memory_order_relaxed);
+        }
+        histograms->sums[probe].store(0, std::memory_order_relaxed);
+    }
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(histograms);
+}
+Profile::ThreadRegistration::~ThreadRegistration()
+{
+    Registry& registry = GetRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (int probe = 0; probe < ProfileProbe::Count; ++probe)
+        {
+            Add(registry.retired[probe], *histograms, probe);
+        }
+        for (std::size_t i = 0; i < registry.threads.size(); ++i)
+        {
+            if (registry.threads[i] == histograms)
+            {
+                registry.threads.erase(registry.threads.begin() + i);
+                break;
+            }
+        }
+    }
+    delete histograms;
+}
+Profile::Registry& Profile::GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+Profile::ThreadHistograms& Profile::Local()
+{
+    static thread_local ThreadRegistration registration;
+    return *registration.histograms;
+}
+void Profile::Record(ProfileProbe_t probe, std::uint64_t nanoseconds)
+{
+    ThreadHistograms& local = Local();
+    // only this thread writes, so a relaxed load and store is enough
+    std::atomic<std::uint64_t>& count = local.counts[probe][LatencyHistogram::BucketOf(nanoseconds)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    local.sums[probe].store(local.sums[probe].load(std::memory_order_relaxed) + nanoseconds,
+                            std::memory_order_relaxed);
+}
+void Profile::Add(LatencyHistogram& histogram, const ThreadHistograms& thread, ProfileProbe_t probe)
+{
+    for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+    {
+        histogram.m_Counts[bucket] += thread.counts[probe][bucket].load(std::memory_order_relaxed);
+    }
+    histogram.m_Sum += thread.sums[probe].load(std::memory_order_relaxed);
+}
+LatencyHistogram Profile::Snapshot(ProfileProbe_t probe)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    LatencyHistogram histogram = registry.retired[probe];
+    for (std::size_t i = 0; i < registry.threads.size(); ++i)
+    {
+        Add(histogram, *registry.threads[i], probe);
+    }
+    return histogram;
+}
+void Profile::Reset()
+{
+    // a count recorded concurrently with the reset may survive it
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (int probe = 0; probe < ProfileProbe::Count; ++probe)
+    {
+        registry.retired[probe] = LatencyHistogram();
+        for (std::size_t i = 0; i < registry.threads.size(); ++i)
+        {
+            for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+            {
+                registry.threads[i]->counts[probe][bucket].store(0, std::memory_order_relaxed);
+            }
+            registry.threads[i]->sums[probe].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+const char* Profile::Name(ProfileProbe_t probe)
+{
+    static const char* const names[ProfileProbe::Count] =
+    {
+        "IsMarketHoliday", "IsTradingDay", "GetNextTradingDay", "CacheHolidays", "CacheTradingDays"
+    };
+    return probe >= 0 && probe < ProfileProbe::Count ? names[probe] : "Unknown";
+}
+void Profile::DumpStatistics(std::FILE* file, const LatencyHistogram& histogram, const char* format)
+{
+    std::uint64_t count = histogram.Count();
+    std::uint64_t lowest = 0;
+    for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+    {
+        if (histogram.BucketCount(bucket) != 0)
+        {
+            lowest = LatencyHistogram::BucketLowest(bucket);
+            break;
+        }
+    }
+    std::fprintf(file, format,
+                 static_cast<unsigned long long>(count),
+                 count == 0 ? 0.0 : static_cast<double>(histogram.Sum()) / count,
+                 static_cast<unsigned long long>(lowest),
+                 static_cast<unsigned long long>(histogram.Percentile(50)),
+                 static_cast<unsigned long long>(histogram.Percentile(90)),
+                 static_cast<unsigned long long>(histogram.Percentile(99)),
+                 static_cast<unsigned long long>(histogram.Percentile(99.9)),
+                 static_cast<unsigned long long>(histogram.Percentile(100)));
+}
+void Profile::DumpText(std::FILE* file)
+{
+    for (int probe = 0; probe < ProfileProbe::Count; ++probe)
+    {
+        std::fprintf(file, "%-18s", Name(probe));
+        DumpStatistics(file, Snapshot(probe),
+                       " count=%llu mean=%.1fns min=%lluns p50=%lluns p90=%lluns"
+                       " p99=%lluns p99.9=%lluns max=%lluns\n");
+    }
+}
+void Profile::DumpJson(std::FILE* file)
+{
+    std::fprintf(file, "{\"probes\":[");
+    for (int probe = 0; probe < ProfileProbe::Count; ++probe)
+    {
+        LatencyHistogram histogram = Snapshot(probe);
+        std::fprintf(file, "%s{\"name\":\"%s\",", probe == 0 ? "" : ",", Name(probe));
+        DumpStatistics(file, histogram,
+                       "\"count\":%llu,\"mean_ns\":%.1f,\"min_ns\":%llu,\"p50_ns\":%llu,\"p90_ns\":%llu,"
+                       "\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu,");
+        std::fprintf(file, "\"buckets\":[");
+        bool first = true;
+        for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+        {
+            if (histogram.BucketCount(bucket) == 0) continue;
+            std::fprintf(file, "%s[%llu,%llu,%llu]", first ? "" : ",",
+                         static_cast<unsigned long long>(LatencyHistogram::BucketLowest(bucket)),
+                         static_cast<unsigned long long>(LatencyHistogram::BucketHighest(bucket)),
+                         static_cast<unsigned long long>(histogram.BucketCount(bucket)));
+            first = false;
+        }
+        std::fprintf(file, "]}");
+    }
+    std::fprintf(file, "]}\n");
+}
+
+} // namespace Holiday
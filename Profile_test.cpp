@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "Profile.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Holiday;
+
+TEST(LatencyHistogram, Buckets)
+{
+    for (std::uint64_t value = 0; value < 16; ++value)
+    {
+        EXPECT_EQ(static_cast<int>(value), LatencyHistogram::BucketOf(value));
+    }
+    EXPECT_EQ(16, LatencyHistogram::BucketOf(16));
+    EXPECT_EQ(31, LatencyHistogram::BucketOf(31));
+    EXPECT_EQ(32, LatencyHistogram::BucketOf(32));
+    EXPECT_EQ(32, LatencyHistogram::BucketOf(33));
+    EXPECT_EQ(LatencyHistogram::Buckets - 1, LatencyHistogram::BucketOf(~std::uint64_t(0)));
+    for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+    {
+        EXPECT_EQ(bucket, LatencyHistogram::BucketOf(LatencyHistogram::BucketLowest(bucket)));
+        EXPECT_EQ(bucket, LatencyHistogram::BucketOf(LatencyHistogram::BucketHighest(bucket)));
+        if (bucket + 1 < LatencyHistogram::Buckets)
+        {
+            EXPECT_EQ(LatencyHistogram::BucketHighest(bucket) + 1, LatencyHistogram::BucketLowest(bucket + 1));
+        }
+    }
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(0u, histogram.Percentile(50));
+    for (std::uint64_t value = 1; value <= 1000; ++value) histogram.Record(value);
+    EXPECT_EQ(1000u, histogram.Count());
+    EXPECT_EQ(500500u, histogram.Sum());
+    // within the 6% bucket precision
+    EXPECT_NEAR(500.0, static_cast<double>(histogram.Percentile(50)), 30.0);
+    EXPECT_NEAR(990.0, static_cast<double>(histogram.Percentile(99)), 60.0);
+    EXPECT_EQ(LatencyHistogram::BucketHighest(LatencyHistogram::BucketOf(1000)), histogram.Percentile(100));
+}
+
+TEST(Profile, RecordsPerThread)
+{
+    Profile::Reset();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.push_back(std::thread([]()
+        {
+            for (int j = 0; j < 1000; ++j) Profile::Record(ProfileProbe::GetNextTradingDay, 100);
+        }));
+    }
+    Profile::Record(ProfileProbe::GetNextTradingDay, 200);
+    for (std::size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    // the histograms of exited threads are kept
+    LatencyHistogram histogram = Profile::Snapshot(ProfileProbe::GetNextTradingDay);
+    EXPECT_EQ(4001u, histogram.Count());
+    EXPECT_EQ(400200u, histogram.Sum());
+    EXPECT_EQ(4000u, histogram.BucketCount(LatencyHistogram::BucketOf(100)));
+    Profile::Reset();
+    EXPECT_EQ(0u, Profile::Snapshot(ProfileProbe::GetNextTradingDay).Count());
+}
+
+TEST(Profile, Dump)
+{
+    Profile::Reset();
+    Profile::Record(ProfileProbe::IsTradingDay, 42);
+    std::FILE* file = std::tmpfile();
+    ASSERT_TRUE(file != NULL);
+    Profile::DumpJson(file);
+    Profile::DumpText(file);
+    std::rewind(file);
+    std::string text;
+    char buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), file)) text += buffer;
+    std::fclose(file);
+    EXPECT_NE(std::string::npos, text.find("{\"name\":\"IsTradingDay\",\"count\":1,\"mean_ns\":42.0,\"min_ns\":42,"));
+    EXPECT_NE(std::string::npos, text.find("\"buckets\":[[42,43,1]]"));
+    EXPECT_NE(std::string::npos, text.find("IsTradingDay       count=1 mean=42.0ns"));
+    EXPECT_NE(std::string::npos, text.find("CacheTradingDays   count=0"));
+    Profile::Reset();
+}
+
+TEST(Profile, CalendarQueries)
+{
+    Profile::Reset();
+    TradingDayCalendar<USMarketHolidays> calendar(2020,2020);
+    calendar.IsTradingDay(20200102);
+    calendar.IsTradingDay(20210102);
+#ifdef HOLIDAY_PROFILE
+    EXPECT_EQ(1u, Profile::Snapshot(ProfileProbe::CacheTradingDays).Count());
+    EXPECT_EQ(2u, Profile::Snapshot(ProfileProbe::IsTradingDay).Count());
+#else
+    EXPECT_EQ(0u, Profile::Snapshot(ProfileProbe::CacheTradingDays).Count());
+    EXPECT_EQ(0u, Profile::Snapshot(ProfileProbe::IsTradingDay).Count());
+#endif
+    Profile::Reset();
+}
@@ -0,0 +1,111 @@
+/// @file
+/// @brief Defines Holiday::SharedCalendar, a cheap handle to an immutable
+///        calendar shared by every component of the process that asks for
+///        the same calendar type and range of years.
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace Holiday
+{
+
+/// @brief Handle to the process-wide snapshot of a calendar.
+///
+///        The Calendar template parameter is any calendar constructible
+///        from (startYear, endYear), e.g. TradingDayCalendar<USMarketHolidays>,
+///        so the registry is keyed by the calendar type (including its
+///        Holidays policy) and the range of years.  The first handle for a
+///        key builds the calendar; every later handle shares it, and copying
+///        a handle is O(1).
+///
+///        Replace() publishes a new snapshot with an atomic pointer swap.
+///        Readers never wait for a rebuild: they either see the old or the
+///        new snapshot, and a snapshot they hold stays valid until released.
+///        Hot loops should take Snapshot() once and query it directly
+///        rather than calling Snapshot() per query.
+template <class Calendar>
+class SharedCalendar
+{
+public:
+    typedef std::shared_ptr<const Calendar> Snapshot_t;
+    /// @brief Handle to the shared calendar for the given years, building
+    ///        it on first use
+    SharedCalendar(int startYear, int endYear);
+    /// @brief Returns the current snapshot
+    Snapshot_t Snapshot() const;
+    /// @brief Atomically publishes a new snapshot to every handle for
+    ///        this calendar type and range of years
+    void Replace(Snapshot_t snapshot) const;
+    /// @brief Builds a fresh calendar for the range and publishes it
+    void Rebuild() const;
+    /// @brief First year of the shared calendar's range
+    int StartYear() const;
+    /// @brief Last year of the shared calendar's range
+    int EndYear() const;
+private:
+    struct Slot
+    {
+        std::once_flag built;
+        Snapshot_t current;
+    };
+    typedef std::pair<int, int> Key_t;
+    static std::shared_ptr<Slot> Find(const Key_t& key);
+    std::shared_ptr<Slot> m_Slot;
+    int m_StartYear;
+    int m_EndYear;
+};
+
+template <class Calendar>
+SharedCalendar<Calendar>::SharedCalendar(int startYear, int endYear)
+{
+    m_StartYear = startYear;
+    m_EndYear = endYear;
+    m_Slot = Find(Key_t(startYear, endYear));
+    // build outside the registry lock so other ranges are not held up
+    Slot& slot = *m_Slot;
+    std::call_once(slot.built, [&slot, startYear, endYear]()
+    {
+        std::atomic_store(&slot.current, Snapshot_t(new Calendar(startYear, endYear)));
+    });
+}
+template <class Calendar>
+std::shared_ptr<typename SharedCalendar<Calendar>::Slot>
+SharedCalendar<Calendar>::Find(const Key_t& key)
+{
+    static std::mutex mutex;
+    static std::map<Key_t, std::shared_ptr<Slot> > registry;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<Slot>& slot = registry[key];
+    if (!slot) slot = std::make_shared<Slot>();
+    return slot;
+}
+template <class Calendar>
+typename SharedCalendar<Calendar>::Snapshot_t SharedCalendar<Calendar>::Snapshot() const
+{
+    return std::atomic_load(&m_Slot->current);
+}
+template <class Calendar>
+void SharedCalendar<Calendar>::Replace(Snapshot_t snapshot) const
+{
+    std::atomic_store(&m_Slot->current, snapshot);
+}
+template <class Calendar>
+void SharedCalendar<Calendar>::Rebuild() const
+{
+    Replace(Snapshot_t(new Calendar(m_StartYear, m_EndYear)));
+}
+template <class Calendar>
+int SharedCalendar<Calendar>::StartYear() const
+{
+    return m_StartYear;
+}
+template <class Calendar>
+int SharedCalendar<Calendar>::EndYear() const
+{
+    return m_EndYear;
+}
+
+} // namespace Holiday
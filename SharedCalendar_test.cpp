@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "SharedCalendar.hpp"
+#include "HolidayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Holiday;
+
+typedef SharedCalendar<TradingDayCalendar<USMarketHolidays> > SharedTradingDays;
+typedef SharedCalendar<HolidayCalendar<USMarketHolidays> > SharedHolidays;
+
+TEST(SharedCalendar, SameRangeShared)
+{
+    SharedTradingDays first(2000, 2040);
+    SharedTradingDays second(2000, 2040);
+    SharedTradingDays copy = first;
+    EXPECT_EQ(first.Snapshot().get(), second.Snapshot().get());
+    EXPECT_EQ(first.Snapshot().get(), copy.Snapshot().get());
+    EXPECT_TRUE(first.Snapshot()->IsTradingDay(20200218));
+    EXPECT_FALSE(first.Snapshot()->IsTradingDay(20200217));
+}
+
+TEST(SharedCalendar, KeyedByTypeAndRange)
+{
+    SharedTradingDays tradingDays(2000, 2040);
+    SharedTradingDays otherRange(2010, 2020);
+    SharedHolidays holidays(2000, 2040);
+    EXPECT_NE(tradingDays.Snapshot().get(), otherRange.Snapshot().get());
+    EXPECT_NE(static_cast<const void*>(tradingDays.Snapshot().get()),
+              static_cast<const void*>(holidays.Snapshot().get()));
+    EXPECT_TRUE(holidays.Snapshot()->IsMarketHoliday(20200217));
+}
+
+TEST(SharedCalendar, Replace)
+{
+    SharedHolidays first(1990, 1995);
+    SharedHolidays second(1990, 1995);
+    SharedHolidays::Snapshot_t old = first.Snapshot();
+    first.Rebuild();
+    EXPECT_NE(old.get(), second.Snapshot().get());
+    EXPECT_EQ(first.Snapshot().get(), second.Snapshot().get());
+    // the old snapshot stays usable while held
+    EXPECT_TRUE(old->IsMarketHoliday(19950102));
+}
+
+TEST(SharedCalendar, ConcurrentReadersAndReplace)
+{
+    SharedTradingDays calendar(1980, 1985);
+    std::atomic<bool> done(false);
+    std::atomic<int> wrong(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.push_back(std::thread([&]()
+        {
+            SharedTradingDays handle(1980, 1985);
+            while (!done)
+            {
+                SharedTradingDays::Snapshot_t snapshot = handle.Snapshot();
+                if (snapshot->IsTradingDay(19850101) || !snapshot->IsTradingDay(19850102)) ++wrong;
+            }
+        }));
+    }
+    for (int i = 0; i < 20; ++i) calendar.Rebuild();
+    done = true;
+    for (size_t t = 0; t < readers.size(); ++t) readers[t].join();
+    EXPECT_EQ(0, wrong);
+}
@@ -0,0 +1,165 @@
+/// @file
+/// @brief Defines Holiday::StaticTradingDayCalendar, a trading day calendar
+///        for a fixed range of years whose bitmap and index are generated
+///        at build time and embedded in the binary.
+#pragma once
+
+#include "Bits.hpp"
+#include "Date.hpp"
+#include "Weekend.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace Holiday
+{
+
+/// @brief Trading day bitmap and ranks of the Holidays and Weekend policies
+///        between StartYear and EndYear.  Only declared here: HolidayGenerate
+///        writes a header defining the specialization for a range of years,
+///        e.g. USMarketTradingDays_2000_2050.hpp, with members
+///
+///            static const int StartDay;        // days since epoch of StartYear-01-01
+///            static const int Days;            // days from StartYear to EndYear
+///            static const int TradingDayCount;
+///            static const std::uint64_t* TradingDays();  // one bit per day
+///            static const std::uint32_t* Ranks();  // trading days before each word
+template <class Holidays, class Weekend, int StartYear, int EndYear>
+struct StaticTradingDayTables;
+
+/// @brief A trading day calendar for the years StartYear to EndYear backed
+///        by constant tables in the binary, so it needs no construction and
+///        the range checks compare against constants.  Dates outside the
+///        range fall back to the Holidays and Weekend rules.
+///
+///        Include the header generated by HolidayGenerate for the policies
+///        and range before using the calendar.
+template <class Holidays, int StartYear, int EndYear, class Weekend = SaturdaySundayWeekend>
+class StaticTradingDayCalendar
+{
+public:
+    typedef StaticTradingDayTables<Holidays, Weekend, StartYear, EndYear> Tables_t;
+    /// @brief Returns true if the provided date is a Trading Day
+    static bool IsTradingDay(int year, int month, int day);
+    /// @brief Returns true if the provided date is a Trading Day
+    static bool IsTradingDay(int yyyymmdd);
+    /// @brief Returns true if the provided date is a Trading Day
+    static bool IsTradingDay(const Date& date);
+    /// @brief Returns the first Trading Day after the provided date, or an
+    ///        invalid date if the provided date is invalid or every day of
+    ///        the week is a weekend day
+    static Date GetNextTradingDay(const Date& date);
+    /// @brief Number of trading days between StartYear and EndYear
+    static int TradingDayCount();
+    /// @brief Returns the index of a trading day within the range among
+    ///        the trading days of the range, or -1
+    static int ToTradingDayIndex(const Date& date);
+    /// @brief Returns the trading day with the given index, or an invalid
+    ///        date if the index is not below TradingDayCount()
+    static Date FromTradingDayIndex(int index);
+    /// @brief Returns the number of trading days from start up to but not
+    ///        including end, negated if end is before start, or 0 if either
+    ///        date is invalid
+    static int CountTradingDays(const Date& start, const Date& end);
+    /// @brief Number of bytes of the tables embedded in the binary
+    static std::size_t MemoryUsage();
+private:
+    static bool InRange(const Date& date);
+    static bool IsTradingDayNoCache(const Date& date);
+    static int TradingDaysBefore(int day);
+};
+
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+bool StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::InRange(const Date& date)
+{
+    return date.Valid() && date.Year() >= StartYear && date.Year() <= EndYear;
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+bool StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::IsTradingDayNoCache(const Date& date)
+{
+    return date.Valid() && !(Holidays::IsMarketHoliday(date) || Weekend::IsWeekend(date));
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+bool StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::IsTradingDay(int year, int month, int day)
+{
+    return IsTradingDay(Date(year, month, day));
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+bool StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::IsTradingDay(int yyyymmdd)
+{
+    return IsTradingDay(Date(yyyymmdd));
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+bool StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::IsTradingDay(const Date& date)
+{
+    if (!InRange(date)) return IsTradingDayNoCache(date);
+    std::size_t day = date.DaysSinceEpoch() - Tables_t::StartDay;
+    return ((Tables_t::TradingDays()[day / 64] >> (day % 64)) & 1u) != 0;
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+Date StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::GetNextTradingDay(const Date& date)
+{
+    if (!date.Valid() || Weekend::Mask == WeekdayMask::All) return Date();
+    Date next = date.GetNextDay();
+    while (!IsTradingDay(next)) next = next.GetNextDay();
+    return next;
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+int StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::TradingDayCount()
+{
+    return Tables_t::TradingDayCount;
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+int StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::ToTradingDayIndex(const Date& date)
+{
+    if (!InRange(date)) return -1;
+    std::size_t day = date.DaysSinceEpoch() - Tables_t::StartDay;
+    std::uint64_t word = Tables_t::TradingDays()[day / 64];
+    std::uint64_t bit = std::uint64_t(1) << (day % 64);
+    if ((word & bit) == 0) return -1;
+    return static_cast<int>(Tables_t::Ranks()[day / 64]) + PopCount(word & (bit - 1));
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+Date StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::FromTradingDayIndex(int index)
+{
+    if (index < 0 || index >= Tables_t::TradingDayCount) return Date();
+    // the last word whose rank is not above the index holds the trading day
+    const std::uint32_t* ranks = Tables_t::Ranks();
+    const std::uint32_t* words = ranks + (Tables_t::Days + 63) / 64;
+    std::size_t word = std::upper_bound(ranks, words, static_cast<std::uint32_t>(index)) - ranks - 1;
+    int bit = SelectBit(Tables_t::TradingDays()[word], index - static_cast<int>(ranks[word]));
+    return Date::FromDaysSinceEpoch(Tables_t::StartDay + static_cast<int>(word * 64) + bit);
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+int StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::CountTradingDays(const Date& start, const Date& end)
+{
+    if (!start.Valid() || !end.Valid()) return 0;
+    int first = start.DaysSinceEpoch() - Tables_t::StartDay;
+    int last = end.DaysSinceEpoch() - Tables_t::StartDay;
+    if (last < first) return -CountTradingDays(end, start);
+    if (first >= 0 && last <= Tables_t::Days)
+    {
+        return TradingDaysBefore(last) - TradingDaysBefore(first);
+    }
+    int count = 0;
+    for (Date date = start; !(date == end); date = date.GetNextDay())
+    {
+        if (IsTradingDay(date)) ++count;
+    }
+    return count;
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+std::size_t StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::MemoryUsage()
+{
+    std::size_t words = (Tables_t::Days + 63) / 64;
+    return words * (sizeof(std::uint64_t) + sizeof(std::uint32_t));
+}
+template <class Holidays, int StartYear, int EndYear, class Weekend>
+int StaticTradingDayCalendar<Holidays, StartYear, EndYear, Weekend>::TradingDaysBefore(int day)
+{
+    if (day == Tables_t::Days) return Tables_t::TradingDayCount;
+    std::uint64_t below = (std::uint64_t(1) << (day % 64)) - 1;
+    return static_cast<int>(Tables_t::Ranks()[day / 64]) + PopCount(Tables_t::TradingDays()[day / 64] & below);
+}
+
+} // namespace Holiday
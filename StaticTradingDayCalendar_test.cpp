@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+#include "StaticTradingDayCalendar.hpp"
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include "USMarketTradingDays_2000_2050.hpp"
+
+using namespace Holiday;
+
+typedef StaticTradingDayCalendar<USMarketHolidays, 2000, 2050> USStaticCalendar;
+
+TEST(StaticTradingDayCalendar, AgreesWithTradingDayCalendar)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2000, 2050);
+    EXPECT_EQ(calendar.TradingDayCount(), USStaticCalendar::TradingDayCount());
+    for (Date date(1995,1,1); date.Year() <= 2055; date = date.GetNextDay())
+    {
+        EXPECT_EQ(calendar.IsTradingDay(date), USStaticCalendar::IsTradingDay(date)) << int(date);
+        int index = calendar.ToTradingDayIndex(date);
+        EXPECT_EQ(index, USStaticCalendar::ToTradingDayIndex(date)) << int(date);
+        if (index >= 0)
+        {
+            EXPECT_EQ(date, USStaticCalendar::FromTradingDayIndex(index)) << index;
+        }
+    }
+}
+
+TEST(StaticTradingDayCalendar, Queries)
+{
+    EXPECT_FALSE(USStaticCalendar::IsTradingDay(20201225));
+    EXPECT_TRUE(USStaticCalendar::IsTradingDay(2020,12,24));
+    EXPECT_FALSE(USStaticCalendar::IsTradingDay(20201301));
+    EXPECT_EQ(20210104, USStaticCalendar::GetNextTradingDay(Date(20201231)));
+    EXPECT_EQ(20000103, USStaticCalendar::FromTradingDayIndex(0));
+    EXPECT_FALSE(USStaticCalendar::FromTradingDayIndex(-1).Valid());
+    EXPECT_FALSE(USStaticCalendar::FromTradingDayIndex(USStaticCalendar::TradingDayCount()).Valid());
+    EXPECT_EQ(4, USStaticCalendar::CountTradingDays(Date(20200101), Date(20200108)));
+    EXPECT_EQ(USStaticCalendar::TradingDayCount(),
+              USStaticCalendar::CountTradingDays(Date(20000101), Date(20510101)));
+    EXPECT_EQ(-5, USStaticCalendar::CountTradingDays(Date(19991231), Date(19991223)));
+    // a bitmap word and a rank for every 64 days
+    std::size_t words = (Date(20510101).DaysSinceEpoch() - Date(20000101).DaysSinceEpoch() + 63) / 64;
+    EXPECT_EQ(words * 12, USStaticCalendar::MemoryUsage());
+}
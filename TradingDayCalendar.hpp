@@ -1,21 +1,39 @@
 #pragma once
 
+#include "Bits.hpp"
 #include "Date.hpp"
-#include <unordered_set>
+#include "Profile.hpp"
+#include "Weekend.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace Holiday
 {
 
 /// @brief A class that can cache trading days using a provided template
-/// parameter to query if the date is a Holiday.  Skips weekends as well.
-template <class Holidays>
+/// parameter to query if the date is a Holiday.  Skips weekends as well,
+/// the weekend days being given by the Weekend policy (see Weekend.hpp).
+///
+/// The cache is a bitmap with one bit per day of the cached years, held
+/// in a single block obtained from the Allocator, e.g. an ArenaAllocator.
+/// A rank per bitmap word and a sampled select table map the cached
+/// trading days to and from their ordinal index.
+/// Copies are deep; moves only transfer the bitmap and never allocate.
+template <class Holidays, class Weekend = SaturdaySundayWeekend,
+          class Allocator = std::allocator<std::uint64_t> >
 class TradingDayCalendar
 {
 public:
     /// @brief  Creates a calendar with no cache
-    TradingDayCalendar();
+    explicit TradingDayCalendar(const Allocator& allocator = Allocator());
     /// @brief Create a calendar caching all TradingDays between the given years
-    TradingDayCalendar(int startYear, int endYear);
+    TradingDayCalendar(int startYear, int endYear, const Allocator& allocator = Allocator());
+    TradingDayCalendar(const TradingDayCalendar&) = default;
+    TradingDayCalendar(TradingDayCalendar&&) = default;
+    TradingDayCalendar& operator=(const TradingDayCalendar&) = default;
+    TradingDayCalendar& operator=(TradingDayCalendar&&) = default;
     /// @brief Caches all TradingDays between the provided years
     void Cache(int startYear, int endYear);
     /// @brief Returns true if the provided date is a Trading Day
@@ -24,73 +42,271 @@ public:
     bool IsTradingDay(int yyyymmdd) const;
     /// @brief Returns true if the provided date is a Trading Day
     bool IsTradingDay(const Date& date) const;
+    /// @brief Returns the first Trading Day after the provided date, or an
+    ///        invalid date if the provided date is invalid or every day of
+    ///        the week is a weekend day
+    Date GetNextTradingDay(const Date& date) const;
+    /// @brief Number of trading days in the cached years
+    int TradingDayCount() const;
+    /// @brief Returns the number of trading days from start up to but not
+    ///        including end, negated if end is before start, or 0 if either
+    ///        date is invalid.  Constant time when both dates are within
+    ///        the cached years or the day after them.
+    int CountTradingDays(const Date& start, const Date& end) const;
+    /// @brief Returns the index of a cached trading day among the cached
+    ///        trading days, counting from 0, or -1 if the date is not a
+    ///        trading day or not cached
+    int ToTradingDayIndex(const Date& date) const;
+    /// @brief Returns the index of a cached trading day, see above
+    int ToTradingDayIndex(int yyyymmdd) const;
+    /// @brief Returns the trading day with the given index, or an invalid
+    ///        date if the index is not below TradingDayCount()
+    Date FromTradingDayIndex(int index) const;
+    /// @brief Writes ToTradingDayIndex of count yyyymmdd dates to indices
+    void ToTradingDayIndex(const int* dates, std::size_t count, int* indices) const;
+    /// @brief Writes FromTradingDayIndex of count indices to dates as
+    ///        yyyymmdd values, -1 for an index out of range
+    void FromTradingDayIndex(const int* indices, std::size_t count, int* dates) const;
+    /// @brief Writes IsTradingDay of count yyyymmdd dates to results
+    void IsTradingDay(const int* dates, std::size_t count, bool* results) const;
+    /// @brief Writes GetNextTradingDay of count yyyymmdd dates to results
+    ///        as yyyymmdd values, -1 where it returns an invalid date
+    void GetNextTradingDay(const int* dates, std::size_t count, int* results) const;
+    /// @brief Approximate number of bytes allocated by the cache
+    std::size_t MemoryUsage() const;
 private:
     bool IsCached(const Date& date) const;
     bool IsTradingDayNoCache(const Date& date) const;
-    std::unordered_set<int> m_CachedTradingDays;
+    int TradingDaysBefore(int day) const;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t> IndexAllocator_t;
+    /// a select sample is kept for every SelectSampleRate trading days
+    static const int SelectSampleRate = 64;
+    std::vector<std::uint64_t, Allocator> m_CachedTradingDays;
+    /// number of trading days before each word of the bitmap
+    std::vector<std::uint32_t, IndexAllocator_t> m_Ranks;
+    /// word holding trading day i * SelectSampleRate
+    std::vector<std::uint32_t, IndexAllocator_t> m_SelectSamples;
+    int m_TradingDayCount;
+    int m_CachedDays;
+    int m_StartDay;
     int m_StartYear;
     int m_EndYear;
 };
 
-template <class Holidays>
-TradingDayCalendar<Holidays>::TradingDayCalendar()
+template <class Holidays, class Weekend, class Allocator>
+TradingDayCalendar<Holidays, Weekend, Allocator>::TradingDayCalendar(const Allocator& allocator)
+    : m_CachedTradingDays(allocator)
+    , m_Ranks(IndexAllocator_t(allocator))
+    , m_SelectSamples(IndexAllocator_t(allocator))
 {
     // no cache
+    m_TradingDayCount = 0;
+    m_CachedDays = 0;
+    m_StartDay = 0;
     m_StartYear = 0;
     m_EndYear = -1;
 }
-template <class Holidays>
-TradingDayCalendar<Holidays>::TradingDayCalendar(int startYear, int endYear)
+template <class Holidays, class Weekend, class Allocator>
+TradingDayCalendar<Holidays, Weekend, Allocator>::TradingDayCalendar(int startYear, int endYear, const Allocator& allocator)
+    : m_CachedTradingDays(allocator)
+    , m_Ranks(IndexAllocator_t(allocator))
+    , m_SelectSamples(IndexAllocator_t(allocator))
 {
     Cache(startYear, endYear);
 }
-template <class Holidays>
-bool TradingDayCalendar<Holidays>::IsTradingDayNoCache(const Date& date) const
+template <class Holidays, class Weekend, class Allocator>
+bool TradingDayCalendar<Holidays, Weekend, Allocator>::IsTradingDayNoCache(const Date& date) const
 {
-    return !(Holidays::IsMarketHoliday(date) || date.IsWeekend());
+    return date.Valid() && !(Holidays::IsMarketHoliday(date) || Weekend::IsWeekend(date));
 }
-template <class Holidays>
-void TradingDayCalendar<Holidays>::Cache(int startYear, int endYear)
+template <class Holidays, class Weekend, class Allocator>
+void TradingDayCalendar<Holidays, Weekend, Allocator>::Cache(int startYear, int endYear)
 {
+    HOLIDAY_PROFILE_SCOPE(ProfileProbe::CacheTradingDays);
     m_StartYear = startYear;
     m_EndYear = endYear;
-    for(Date date(startYear,1,1); date.Year() <= endYear; date = date.GetNextDay())
+    m_StartDay = Date(startYear,1,1).DaysSinceEpoch();
+    std::size_t days = startYear <= endYear
+        ? Date(endYear,12,31).DaysSinceEpoch() - m_StartDay + 1
+        : 0;
+    m_CachedDays = static_cast<int>(days);
+    // a fresh vector so the bitmap is a single allocation of the exact size
+    std::vector<std::uint64_t, Allocator>((days + 63) / 64, 0, m_CachedTradingDays.get_allocator()).swap(m_CachedTradingDays);
+
+    // The weekday of bit i repeats every 7 days and 7 words hold 448 = 7 * 64
+    // days, so build the weekday pattern for 7 words once and copy it out.
+    std::uint64_t pattern[7];
+    int startDayOfWeek = Date(startYear,1,1).GetDayOfWeek();
+    for (int word = 0; word < 7; ++word)
     {
-        if (IsTradingDayNoCache(date))
+        pattern[word] = 0;
+        for (int bit = 0; bit < 64; ++bit)
         {
-            m_CachedTradingDays.insert(date);
+            int dayofweek = (startDayOfWeek + word * 64 + bit) % 7;
+            if (((Weekend::Mask >> dayofweek) & 1u) == 0)
+            {
+                pattern[word] |= std::uint64_t(1) << bit;
+            }
         }
     }
+    for (std::size_t word = 0; word < m_CachedTradingDays.size(); ++word)
+    {
+        m_CachedTradingDays[word] = pattern[word % 7];
+    }
+    if (days % 64 != 0)
+    {
+        m_CachedTradingDays.back() &= (std::uint64_t(1) << (days % 64)) - 1;
+    }
+
+    // then clear the holidays that fall on a weekday
+    std::size_t day = 0;
+    for(Date date(startYear,1,1); day < days; date = date.GetNextDay(), ++day)
+    {
+        std::uint64_t bit = std::uint64_t(1) << (day % 64);
+        if ((m_CachedTradingDays[day / 64] & bit) != 0 && Holidays::IsMarketHoliday(date))
+        {
+            m_CachedTradingDays[day / 64] &= ~bit;
+        }
+    }
+
+    // finally index the trading days
+    std::size_t words = m_CachedTradingDays.size();
+    std::vector<std::uint32_t, IndexAllocator_t>(words, 0, m_Ranks.get_allocator()).swap(m_Ranks);
+    std::uint32_t rank = 0;
+    for (std::size_t word = 0; word < words; ++word)
+    {
+        m_Ranks[word] = rank;
+        rank += PopCount(m_CachedTradingDays[word]);
+    }
+    m_TradingDayCount = static_cast<int>(rank);
+    std::vector<std::uint32_t, IndexAllocator_t>((rank + SelectSampleRate - 1) / SelectSampleRate, 0,
+                                                 m_SelectSamples.get_allocator()).swap(m_SelectSamples);
+    std::size_t word = 0;
+    for (std::size_t sample = 0; sample < m_SelectSamples.size(); ++sample)
+    {
+        std::uint32_t index = static_cast<std::uint32_t>(sample * SelectSampleRate);
+        while (word + 1 < words && m_Ranks[word + 1] <= index) ++word;
+        m_SelectSamples[sample] = static_cast<std::uint32_t>(word);
+    }
+}
+template <class Holidays, class Weekend, class Allocator>
+bool TradingDayCalendar<Holidays, Weekend, Allocator>::IsCached(const Date& date) const
+{
+    return date.Valid() && date.Year() >= m_StartYear && date.Year() <= m_EndYear;
+}
+template <class Holidays, class Weekend, class Allocator>
+bool TradingDayCalendar<Holidays, Weekend, Allocator>::IsTradingDay(int year, int month, int day) const
+{
+    return IsTradingDay(Date(year, month, day));
+}
+template <class Holidays, class Weekend, class Allocator>
+bool TradingDayCalendar<Holidays, Weekend, Allocator>::IsTradingDay(int yyyymmdd) const
+{
+    return IsTradingDay(Date(yyyymmdd));
+}
+template <class Holidays, class Weekend, class Allocator>
+bool TradingDayCalendar<Holidays, Weekend, Allocator>::IsTradingDay(const Date& date) const
+{
+    HOLIDAY_PROFILE_SCOPE(ProfileProbe::IsTradingDay);
+    if (!IsCached(date)) return IsTradingDayNoCache(date);
+    std::size_t day = date.DaysSinceEpoch() - m_StartDay;
+    return ((m_CachedTradingDays[day / 64] >> (day % 64)) & 1u) != 0;
+}
+template <class Holidays, class Weekend, class Allocator>
+Date TradingDayCalendar<Holidays, Weekend, Allocator>::GetNextTradingDay(const Date& date) const
+{
+    HOLIDAY_PROFILE_SCOPE(ProfileProbe::GetNextTradingDay);
+    if (!date.Valid() || Weekend::Mask == WeekdayMask::All) return Date();
+    Date next = date.GetNextDay();
+    while (!IsTradingDay(next)) next = next.GetNextDay();
+    return next;
+}
+template <class Holidays, class Weekend, class Allocator>
+int TradingDayCalendar<Holidays, Weekend, Allocator>::TradingDayCount() const
+{
+    return m_TradingDayCount;
+}
+template <class Holidays, class Weekend, class Allocator>
+int TradingDayCalendar<Holidays, Weekend, Allocator>::CountTradingDays(const Date& start, const Date& end) const
+{
+    if (!start.Valid() || !end.Valid()) return 0;
+    int first = start.DaysSinceEpoch() - m_StartDay;
+    int last = end.DaysSinceEpoch() - m_StartDay;
+    if (last < first) return -CountTradingDays(end, start);
+    if (first >= 0 && last <= m_CachedDays)
+    {
+        return TradingDaysBefore(last) - TradingDaysBefore(first);
+    }
+    int count = 0;
+    for (Date date = start; !(date == end); date = date.GetNextDay())
+    {
+        if (IsTradingDay(date)) ++count;
+    }
+    return count;
+}
+template <class Holidays, class Weekend, class Allocator>
+int TradingDayCalendar<Holidays, Weekend, Allocator>::TradingDaysBefore(int day) const
+{
+    if (day == m_CachedDays) return m_TradingDayCount;
+    std::uint64_t below = (std::uint64_t(1) << (day % 64)) - 1;
+    return static_cast<int>(m_Ranks[day / 64]) + PopCount(m_CachedTradingDays[day / 64] & below);
+}
+template <class Holidays, class Weekend, class Allocator>
+int TradingDayCalendar<Holidays, Weekend, Allocator>::ToTradingDayIndex(const Date& date) const
+{
+    if (!IsCached(date)) return -1;
+    std::size_t day = date.DaysSinceEpoch() - m_StartDay;
+    std::uint64_t word = m_CachedTradingDays[day / 64];
+    std::uint64_t bit = std::uint64_t(1) << (day % 64);
+    if ((word & bit) == 0) return -1;
+    return static_cast<int>(m_Ranks[day / 64]) + PopCount(word & (bit - 1));
+}
+template <class Holidays, class Weekend, class Allocator>
+int TradingDayCalendar<Holidays, Weekend, Allocator>::ToTradingDayIndex(int yyyymmdd) const
+{
+    return ToTradingDayIndex(Date(yyyymmdd));
+}
+template <class Holidays, class Weekend, class Allocator>
+Date TradingDayCalendar<Holidays, Weekend, Allocator>::FromTradingDayIndex(int index) const
+{
+    if (index < 0 || index >= m_TradingDayCount) return Date();
+    // the sample leaves at most SelectSampleRate trading days to skip, so
+    // only a few words for any weekend with at least one trading day
+    std::size_t word = m_SelectSamples[index / SelectSampleRate];
+    std::uint32_t rank = static_cast<std::uint32_t>(index);
+    while (word + 1 < m_Ranks.size() && m_Ranks[word + 1] <= rank) ++word;
+    int bit = SelectBit(m_CachedTradingDays[word], static_cast<int>(rank - m_Ranks[word]));
+    return Date::FromDaysSinceEpoch(m_StartDay + static_cast<int>(word * 64) + bit);
+}
+template <class Holidays, class Weekend, class Allocator>
+void TradingDayCalendar<Holidays, Weekend, Allocator>::ToTradingDayIndex(const int* dates, std::size_t count,
+                                                                         int* indices) const
+{
+    for (std::size_t i = 0; i < count; ++i) indices[i] = ToTradingDayIndex(Date(dates[i]));
 }
-template <class Holidays>
-bool TradingDayCalendar<Holidays>::IsCached(const Date& date) const
+template <class Holidays, class Weekend, class Allocator>
+void TradingDayCalendar<Holidays, Weekend, Allocator>::FromTradingDayIndex(const int* indices, std::size_t count,
+                                                                           int* dates) const
 {
-    return date.Year() >= m_StartYear && date.Year() <= m_EndYear;
+    for (std::size_t i = 0; i < count; ++i) dates[i] = FromTradingDayIndex(indices[i]);
 }
-template<class Holidays>
-bool TradingDayCalendar<Holidays>::IsTradingDay(int year, int month, int day) const
+template <class Holidays, class Weekend, class Allocator>
+void TradingDayCalendar<Holidays, Weekend, Allocator>::IsTradingDay(const int* dates, std::size_t count,
+                                                                    bool* results) const
 {
-    Date date(year, month, day);
-    int yyyymmdd = date;
-    return IsCached(date)
-        ? m_CachedTradingDays.count(yyyymmdd) != 0
-        : IsTradingDayNoCache(date);
+    for (std::size_t i = 0; i < count; ++i) results[i] = IsTradingDay(Date(dates[i]));
 }
-template<class Holidays>
-bool TradingDayCalendar<Holidays>::IsTradingDay(int yyyymmdd) const
+template <class Holidays, class Weekend, class Allocator>
+void TradingDayCalendar<Holidays, Weekend, Allocator>::GetNextTradingDay(const int* dates, std::size_t count,
+                                                                         int* results) const
 {
-    Date date(yyyymmdd);
-    return IsCached(date)
-        ? m_CachedTradingDays.count(yyyymmdd) != 0
-        : IsTradingDayNoCache(date);
+    for (std::size_t i = 0; i < count; ++i) results[i] = GetNextTradingDay(Date(dates[i]));
 }
-template<class Holidays>
-bool TradingDayCalendar<Holidays>::IsTradingDay(const Date& date) const
+template <class Holidays, class Weekend, class Allocator>
+std::size_t TradingDayCalendar<Holidays, Weekend, Allocator>::MemoryUsage() const
 {
-    int yyyymmdd = date;
-    return IsCached(date)
-        ? m_CachedTradingDays.count(yyyymmdd) != 0
-        : IsTradingDayNoCache(date);
+    return m_CachedTradingDays.capacity() * sizeof(std::uint64_t)
+         + (m_Ranks.capacity() + m_SelectSamples.capacity()) * sizeof(std::uint32_t);
 }
 
 } // namespace Holiday
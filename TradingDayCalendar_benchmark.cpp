@@ -0,0 +1,92 @@
+/// @file
+/// @brief Measures how IsTradingDay throughput scales with the number of
+///        threads querying a shared calendar.  Since Date uses no libc time
+///        functions or global state, throughput should grow linearly with
+///        the thread count up to the number of physical cores.
+///
+///        Usage: TradingDayCalendar_benchmark [maxThreads] [passes]
+///
+///        Built with HOLIDAY_PROFILE it also prints the latency histograms
+///        of the queries.
+#include "TradingDayCalendar.hpp"
+#include "USMarketHolidays.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Holiday;
+
+namespace
+{
+
+template <class Calendar>
+double Run(const Calendar& calendar, const std::vector<int>& dates,
+           unsigned threads, int passes)
+{
+    std::vector<std::thread> workers;
+    std::vector<long> counts(threads);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.push_back(std::thread([&, t]()
+        {
+            long count = 0;
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                for (size_t i = 0; i < dates.size(); ++i)
+                {
+                    count += calendar.IsTradingDay(dates[i]) ? 1 : 0;
+                }
+            }
+            counts[t] = count;
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // every thread answers the same queries so the counts must agree
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        if (counts[t] != counts[0]) std::abort();
+    }
+    return static_cast<double>(dates.size()) * passes * threads / elapsed.count();
+}
+
+template <class Calendar>
+void Report(const char* name, const Calendar& calendar,
+            const std::vector<int>& dates, unsigned maxThreads, int passes)
+{
+    double single = 0;
+    std::printf("%-10s %8s %16s %8s\n", name, "threads", "queries/sec", "speedup");
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        double rate = Run(calendar, dates, threads, passes);
+        if (threads == 1) single = rate;
+        std::printf("%-10s %8u %16.0f %8.2f\n", name, threads, rate, rate / single);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    unsigned maxThreads = argc > 1 ? std::atoi(argv[1]) : std::thread::hardware_concurrency();
+    int passes = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (maxThreads == 0) maxThreads = 1;
+
+    std::vector<int> dates;
+    for (Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    {
+        dates.push_back(date);
+    }
+
+    TradingDayCalendar<USMarketHolidays> cached(2000, 2040);
+    TradingDayCalendar<USMarketHolidays> uncached;
+    Report("cached", cached, dates, maxThreads, passes);
+    Report("uncached", uncached, dates, maxThreads, passes);
+#ifdef HOLIDAY_PROFILE
+    Profile::DumpText(stdout);
+#endif
+    return 0;
+}
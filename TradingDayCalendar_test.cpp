@@ -50,3 +50,116 @@ TEST(TradingDayCalendar, KnownUSMarketHolidaysNoCache)
         EXPECT_EQ(isTradingDay, calendar.IsTradingDay(date)) << yyyymmdd;
     }
 }
+
+TEST(TradingDayCalendar, GetNextTradingDay)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2010,2020);
+    EXPECT_EQ(20200102, calendar.GetNextTradingDay(Date(20191231)));
+    EXPECT_EQ(20200218, calendar.GetNextTradingDay(Date(20200214)));
+    EXPECT_EQ(20200413, calendar.GetNextTradingDay(Date(20200409)));
+    EXPECT_EQ(20200220, calendar.GetNextTradingDay(Date(20200219)));
+    EXPECT_EQ(20210104, calendar.GetNextTradingDay(Date(20201231)));
+    EXPECT_FALSE(calendar.GetNextTradingDay(Date(20201301)).Valid());
+}
+
+TEST(TradingDayCalendar, FridaySaturdayWeekend)
+{
+    TradingDayCalendar<USMarketHolidays, FridaySaturdayWeekend> cached(2010,2020);
+    TradingDayCalendar<USMarketHolidays, FridaySaturdayWeekend> uncached;
+    for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    {
+        int yyyymmdd = date;
+        bool isKnownHoliday = std::find(std::begin(KnownUSMarketHolidays),
+                                        std::end(KnownUSMarketHolidays),
+                                        yyyymmdd) != std::end(KnownUSMarketHolidays);
+        bool isWeekend = date.GetDayOfWeek() == DayOfWeek::Friday
+                      || date.GetDayOfWeek() == DayOfWeek::Saturday;
+        bool isTradingDay = !isKnownHoliday && !isWeekend;
+        EXPECT_EQ(isTradingDay, cached.IsTradingDay(date)) << yyyymmdd;
+        EXPECT_EQ(isTradingDay, uncached.IsTradingDay(date)) << yyyymmdd;
+    }
+    EXPECT_EQ(20200216, cached.GetNextTradingDay(Date(20200213)));
+}
+
+TEST(TradingDayCalendar, NoWeekend)
+{
+    TradingDayCalendar<USMarketHolidays, WeekendDays<WeekdayMask::None> > calendar(2020,2020);
+    EXPECT_TRUE(calendar.IsTradingDay(20200215));
+    EXPECT_FALSE(calendar.IsTradingDay(20200217));
+    TradingDayCalendar<USMarketHolidays, WeekendDays<WeekdayMask::All> > closed(2020,2020);
+    EXPECT_FALSE(closed.IsTradingDay(20200218));
+    EXPECT_FALSE(closed.GetNextTradingDay(Date(20200218)).Valid());
+}
+
+TEST(TradingDayCalendar, MemoryUsage)
+{
+    TradingDayCalendar<USMarketHolidays> noCache;
+    TradingDayCalendar<USMarketHolidays> calendar(2000,2040);
+    EXPECT_EQ(0u, noCache.MemoryUsage());
+    // one bit per day, a rank per 64 days and a select sample per 64 trading days
+    std::size_t words = (Date(20401231).DaysSinceEpoch() - Date(20000101).DaysSinceEpoch() + 64) / 64;
+    EXPECT_EQ(words * 8 + words * 4 + (calendar.TradingDayCount() + 63) / 64 * 4,
+              calendar.MemoryUsage());
+}
+
+TEST(TradingDayCalendar, TradingDayIndex)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2000,2040);
+    TradingDayCalendar<USMarketHolidays, WeekendDays<WeekdayMask::All & ~WeekdayMask::Wednesday> > wednesdays(2000,2040);
+    EXPECT_EQ(0, calendar.ToTradingDayIndex(20000103));
+    EXPECT_EQ(20000103, calendar.FromTradingDayIndex(0));
+    EXPECT_EQ(-1, calendar.ToTradingDayIndex(20000101));
+    EXPECT_EQ(-1, calendar.ToTradingDayIndex(19991231));
+    EXPECT_EQ(-1, calendar.ToTradingDayIndex(20001301));
+    EXPECT_FALSE(calendar.FromTradingDayIndex(-1).Valid());
+    EXPECT_FALSE(calendar.FromTradingDayIndex(calendar.TradingDayCount()).Valid());
+    EXPECT_EQ(20401231, calendar.FromTradingDayIndex(calendar.TradingDayCount() - 1));
+    EXPECT_EQ(-1, wednesdays.ToTradingDayIndex(20000103));
+    EXPECT_EQ(0, wednesdays.ToTradingDayIndex(20000105));
+
+    int index = 0;
+    int wednesdayIndex = 0;
+    for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    {
+        if (calendar.IsTradingDay(date))
+        {
+            EXPECT_EQ(index, calendar.ToTradingDayIndex(date)) << int(date);
+            EXPECT_EQ(date, calendar.FromTradingDayIndex(index)) << index;
+            ++index;
+        }
+        if (wednesdays.IsTradingDay(date))
+        {
+            EXPECT_EQ(date, wednesdays.FromTradingDayIndex(wednesdayIndex++)) << int(date);
+        }
+    }
+    EXPECT_EQ(index, calendar.TradingDayCount());
+    EXPECT_EQ(wednesdayIndex, wednesdays.TradingDayCount());
+}
+
+TEST(TradingDayCalendar, TradingDayIndexBatch)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2020,2020);
+    const int dates[] = { 20200102, 20200101, 20200103, 20201231, 20210104 };
+    int indices[5];
+    calendar.ToTradingDayIndex(dates, 5, indices);
+    const int expectedIndices[] = { 0, -1, 1, calendar.TradingDayCount() - 1, -1 };
+    EXPECT_TRUE(std::equal(indices, indices + 5, expectedIndices));
+    int roundTrip[5];
+    calendar.FromTradingDayIndex(indices, 5, roundTrip);
+    const int expectedDates[] = { 20200102, -1, 20200103, 20201231, -1 };
+    EXPECT_TRUE(std::equal(roundTrip, roundTrip + 5, expectedDates));
+}
+
+TEST(TradingDayCalendar, QueryBatch)
+{
+    TradingDayCalendar<USMarketHolidays> calendar(2020,2020);
+    const int dates[] = { 20200102, 20200101, 20201231, 20210101, 20201301 };
+    bool tradingDays[5];
+    calendar.IsTradingDay(dates, 5, tradingDays);
+    const bool expectedTradingDays[] = { true, false, true, false, false };
+    EXPECT_TRUE(std::equal(tradingDays, tradingDays + 5, expectedTradingDays));
+    int next[5];
+    calendar.GetNextTradingDay(dates, 5, next);
+    const int expectedNext[] = { 20200103, 20200102, 20210104, 20210104, -1 };
+    EXPECT_TRUE(std::equal(next, next + 5, expectedNext));
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Date.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 namespace Holiday
 {
@@ -40,7 +43,107 @@ public:
         }
         return false;
     }
+    /// @brief Writes IsMarketHoliday of count yyyymmdd dates to results.
+    ///
+    ///        Rather than building Dates, every rule is evaluated for every
+    ///        date with branch-free integer arithmetic and a lookup in a
+    ///        constant table of the fixed-date and weekday rules.  Good
+    ///        Friday is looked up in a table computed once per batch for
+    ///        the years the dates span, unless that is more than
+    ///        EasterTableYears or than the number of dates, so bulk queries
+    ///        for historical years outside any cache run close to cached
+    ///        speed.  Allocates nothing.
+    static void IsMarketHoliday(const int* dates, std::size_t count, bool* results)
+    {
+        if (count == 0) return;
+        int minYear = dates[0] / 10000;
+        int maxYear = minYear;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            minYear = std::min(minYear, dates[i] / 10000);
+            maxYear = std::max(maxYear, dates[i] / 10000);
+        }
+        // a table is only worth computing for fewer years than dates
+        std::size_t years = maxYear - minYear + 1;
+        if (years <= EasterTableYears && years <= count)
+        {
+            int goodFridays[EasterTableYears];
+            for (int year = minYear; year <= maxYear; ++year)
+            {
+                goodFridays[year - minYear] = GetGoodFridayMonthDay(year);
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                results[i] = IsRuleHoliday(dates[i], goodFridays[dates[i] / 10000 - minYear]);
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                results[i] = IsRuleHoliday(dates[i], GetGoodFridayMonthDay(dates[i] / 10000));
+            }
+        }
+    }
 private:
+    /// @brief Most years of Good Fridays a batch computes up front
+    static const std::size_t EasterTableYears = 512;
+    /// @brief Bits first to last of a mask of the days of a month
+    static constexpr std::uint32_t Days(int first, int last)
+    {
+        return (~0u >> (31 - last)) & (~0u << first);
+    }
+    /// @brief The rules of IsMarketHoliday other than Good Friday as a
+    ///        mask of the holidays of each month, 1 to 12, for each day of
+    ///        the week the holiday can fall on.
+    static const std::uint32_t* RuleTable()
+    {
+        static const std::uint32_t rules[13 * 7] =
+        {
+            //  Sunday  Monday                        Tuesday       Wednesday     Thursday       Friday        Saturday
+            0,      0,                            0,            0,            0,             0,            0,
+            0,      Days(1,2) | Days(15,21),      Days(1,1),    Days(1,1),    Days(1,1),     Days(1,1),    0, // Janurary
+            0,      Days(15,21),                  0,            0,            0,             0,            0, // Feburary
+            0,      0,                            0,            0,            0,             0,            0, // March
+            0,      0,                            0,            0,            0,             0,            0, // April
+            0,      Days(25,31),                  0,            0,            0,             0,            0, // May
+            0,      0,                            0,            0,            0,             0,            0, // June
+            0,      Days(4,5),                    Days(4,4),    Days(4,4),    Days(4,4),     Days(3,4),    0, // July
+            0,      0,                            0,            0,            0,             0,            0, // August
+            0,      Days(1,7),                    0,            0,            0,             0,            0, // September
+            0,      0,                            0,            0,            0,             0,            0, // October
+            0,      0,                            0,            0,            Days(22,28),   0,            0, // November
+            0,      Days(25,26),                  Days(25,25),  Days(25,25),  Days(25,25),   Days(24,25),  0, // December
+        };
+        return rules;
+    }
+    /// @brief IsMarketHoliday of a yyyymmdd date given Good Friday of its
+    ///        year as mmdd, computed with integer arithmetic and a lookup
+    ///        in RuleTable so the batch loop has no branches.
+    static bool IsRuleHoliday(int yyyymmdd, int goodFriday)
+    {
+        // a negative yyyymmdd is never a valid date, and unsigned
+        // arithmetic divides by constants without fixing up the sign
+        unsigned value = yyyymmdd < 0 ? 0 : yyyymmdd;
+        unsigned yyyymm = value / 100;
+        unsigned year = yyyymm / 100;
+        unsigned month = yyyymm - year * 100;
+        unsigned day = value - yyyymm * 100;
+        bool leap = ((year % 4 == 0) & (year % 100 != 0)) | (year % 400 == 0);
+        // 31 days in odd months up to July and even months from August
+        unsigned daysInMonth = 30 + ((month + (month >> 3)) & 1) - (month == Month::Feburary) * (leap ? 1 : 2);
+        bool valid = (month - 1 < 12) & (day - 1 < daysInMonth);
+
+        // days since a Wednesday, 1 March of a year before 0 that has the
+        // same day of the week, counting years from March
+        unsigned y = year + 400 - (month <= Month::Feburary);
+        unsigned dayOfYear = (153 * (month > Month::Feburary ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        unsigned dayofweek = (y + y / 4 - y / 100 + y / 400 + dayOfYear + DayOfWeek::Wednesday) % 7;
+
+        std::uint32_t rules = RuleTable()[valid ? month * 7 + dayofweek : 0];
+        bool goodFridayMatch = static_cast<int>(month * 100 + day) == goodFriday;
+        return valid & ((((rules >> (day & 31)) & 1) != 0) | goodFridayMatch);
+    }
     /// @brief Observed New Year's Day is the first Monday of Janurary unless
     ///        New Year's Day proper falls on a Saturday then there is no
     ///        observed holiday for that year.
@@ -78,6 +181,20 @@ private:
     static Date GetGoodFriday(int year)
     {
         int month, day;
+        GetGoodFriday(year, month, day);
+        return Date(year,month,day);
+    }
+    /// @brief Good Friday of the year as mmdd, see GetGoodFriday
+    static int GetGoodFridayMonthDay(int year)
+    {
+        int month, day;
+        GetGoodFriday(year, month, day);
+        return month * 100 + day;
+    }
+    /// @brief The Computus of GetGoodFriday, using only integer arithmetic
+    ///        so a range of years can be computed in a loop
+    static void GetGoodFriday(int year, int& month, int& day)
+    {
         int a = year % 19;
         int b = year / 100;
         int c = year % 100;
@@ -92,7 +209,6 @@ private:
         int days_to_good_friday = h + l - (7*m) - 2;
         month = (days_to_good_friday + 90) / 25;
         day = (days_to_good_friday + (33 * month) + 19) % 32;
-        return Date(year,month,day);
     }
     /// @brief Memorial Day is the first Monday of May.
     static Date GetMemorialDay(int year)
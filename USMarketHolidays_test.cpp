@@ -1,18 +1,61 @@
 #include "gtest/gtest.h"
 #include "USMarketHolidays.hpp"
 #include "KnownUSMarketHolidays.hpp"
+#include "CalendarValidator.hpp"
 #include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
 
 using namespace Holiday;
 
 TEST(USMarketHolidays, FromFile)
 {
-    for(Date date(2000,1,1); date.Year() <= 2040; date = date.GetNextDay())
+    CalendarValidator<USMarketHolidays> validator(2000, 2040);
+    std::vector<int> reference(std::begin(KnownUSMarketHolidays), std::end(KnownUSMarketHolidays));
+    std::vector<YearDifferences> differences = validator.Validate(reference);
+    for (std::size_t i = 0; i < differences.size(); ++i)
     {
-        int yyyymmdd = date;
-        bool isKnownHoliday = std::find(std::begin(KnownUSMarketHolidays),
-                                        std::end(KnownUSMarketHolidays),
-                                        yyyymmdd) != std::end(KnownUSMarketHolidays);
-        EXPECT_EQ(isKnownHoliday, USMarketHolidays::IsMarketHoliday(date)) << yyyymmdd;
+        for (std::size_t j = 0; j < differences[i].missing.size(); ++j)
+        {
+            ADD_FAILURE() << "missing " << differences[i].missing[j];
+        }
+        for (std::size_t j = 0; j < differences[i].extra.size(); ++j)
+        {
+            ADD_FAILURE() << "extra " << differences[i].extra[j];
+        }
     }
 }
+
+TEST(USMarketHolidays, BatchMatchesScalar)
+{
+    std::vector<int> dates;
+    for (Date date(1583,1,1); date.Year() <= 2400; date = date.GetNextDay())
+    {
+        dates.push_back(date);
+    }
+    const int invalid[] = { 0, -1, 20200000, 20200132, 20200230, 20190229, 20201301, 20201225 + 100, -20201225 };
+    dates.insert(dates.end(), std::begin(invalid), std::end(invalid));
+
+    // the dates span too many years for the Good Friday table
+    std::unique_ptr<bool[]> results(new bool[dates.size()]);
+    USMarketHolidays::IsMarketHoliday(dates.data(), dates.size(), results.get());
+    for (std::size_t i = 0; i < dates.size(); ++i)
+    {
+        EXPECT_EQ(USMarketHolidays::IsMarketHoliday(Date(dates[i])), results[i]) << dates[i];
+    }
+
+    // each chunk spans a few years so Good Friday comes from the table
+    const std::size_t chunk = 1000;
+    for (std::size_t begin = 0; begin < dates.size(); begin += chunk)
+    {
+        std::size_t count = std::min(chunk, dates.size() - begin);
+        bool batch[chunk];
+        USMarketHolidays::IsMarketHoliday(&dates[begin], count, batch);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(USMarketHolidays::IsMarketHoliday(Date(dates[begin + i])), batch[i]) << dates[begin + i];
+        }
+    }
+    USMarketHolidays::IsMarketHoliday(dates.data(), 0, NULL);
+}
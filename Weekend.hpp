@@ -0,0 +1,44 @@
+/// @file
+/// @brief Defines weekday masks and the weekend policies used by
+///        Holiday::TradingDayCalendar
+#pragma once
+
+#include "Date.hpp"
+
+namespace Holiday
+{
+
+/// @brief A set of days of the week, bit n set for day of the week n
+typedef unsigned WeekdayMask_t;
+namespace WeekdayMask
+{
+    static const WeekdayMask_t None = 0;
+    static const WeekdayMask_t Sunday = 1u << DayOfWeek::Sunday;
+    static const WeekdayMask_t Monday = 1u << DayOfWeek::Monday;
+    static const WeekdayMask_t Tuesday = 1u << DayOfWeek::Tuesday;
+    static const WeekdayMask_t Wednesday = 1u << DayOfWeek::Wednesday;
+    static const WeekdayMask_t Thursday = 1u << DayOfWeek::Thursday;
+    static const WeekdayMask_t Friday = 1u << DayOfWeek::Friday;
+    static const WeekdayMask_t Saturday = 1u << DayOfWeek::Saturday;
+    static const WeekdayMask_t All = 0x7f;
+}
+
+/// @brief Weekend policy whose weekend days are the days in the mask
+template <WeekdayMask_t Days>
+class WeekendDays
+{
+public:
+    static const WeekdayMask_t Mask = Days & WeekdayMask::All;
+    /// @brief Returns true if the date is valid and falls on a weekend day
+    static bool IsWeekend(const Date& date)
+    {
+        return date.Valid() && ((Mask >> date.GetDayOfWeek()) & 1u) != 0;
+    }
+};
+
+/// @brief Saturday and Sunday weekend used by most markets
+typedef WeekendDays<WeekdayMask::Saturday | WeekdayMask::Sunday> SaturdaySundayWeekend;
+/// @brief Friday and Saturday weekend used by several Middle-Eastern markets
+typedef WeekendDays<WeekdayMask::Friday | WeekdayMask::Saturday> FridaySaturdayWeekend;
+
+} // namespace Holiday